@@ -2182,6 +2182,7 @@ projects/mint/tests/Makefile
 projects/vectorization/Makefile
 projects/vectorization/src/Makefile
 projects/vectorization/tests/Makefile
+projects/vectorization/benchmarks/Makefile
 projects/Fortran_to_C/Makefile
 projects/Fortran_to_C/src/Makefile
 projects/Fortran_to_C/tests/Makefile
@@ -2310,6 +2311,7 @@ tests/roseTests/programAnalysisTests/ssa_UnfilteredCfg_Test/Makefile
 tests/roseTests/programAnalysisTests/staticSingleAssignmentTests/Makefile
 tests/roseTests/programAnalysisTests/generalDataFlowAnalysisTests/Makefile
 tests/roseTests/programAnalysisTests/systemDependenceGraphTests/Makefile
+tests/roseTests/programAnalysisTests/distributedMemoryAnalysisTests/Makefile
 tests/roseTests/programTransformationTests/Makefile
 tests/roseTests/programTransformationTests/extractFunctionArgumentsTest/Makefile
 tests/roseTests/roseHPCToolkitTests/Makefile
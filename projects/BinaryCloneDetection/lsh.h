@@ -10,6 +10,7 @@
 #include <boost/random.hpp>
 #include <boost/smart_ptr.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/scoped_ptr.hpp>
 
 #include <cstring>
 
@@ -78,6 +79,29 @@ void insert_into_postprocessed_clusters(
     );
 
 
+// Inserts rows into the clusters and postprocessed_clusters tables through statements that are prepared once. Rows are
+// grouped into transactions of about rowsPerTransaction rows, but a transaction is only committed between clusters (see
+// end_cluster()), so each cluster is written atomically. The functions above prepare a statement per row and rely on the
+// caller for transactions.
+class ClusterWriter {
+  sqlite3x::sqlite3_connection& con;
+  sqlite3x::sqlite3_command clustersCmd, postprocessedClustersCmd;
+  boost::scoped_ptr<sqlite3x::sqlite3_transaction> trans;
+  size_t rowsPerTransaction, rowsInTransaction;
+
+  public:
+  ClusterWriter(sqlite3x::sqlite3_connection& con, size_t rowsPerTransaction = 100000);
+  ~ClusterWriter(); // Commits outstanding rows
+
+  void insert_into_clusters(int cluster, int function_id, int index_within_function, int vectors_row, double dist);
+  void insert_into_postprocessed_clusters(int cluster, int function_id, int index_within_function, int vectors_row, double dist);
+  void end_cluster(); // Commit the current transaction if it is full; call only between clusters
+  void flush(); // Commit the current transaction
+
+  private:
+  ClusterWriter(const ClusterWriter&); // Not copyable
+};
+
 void get_run_parameters(sqlite3x::sqlite3_connection& con, int& windowSize, int& stride);
 
 
@@ -239,16 +263,26 @@ class HashTableGroup {
 
 struct L1DistanceObject {
   double operator()(const scoped_array_with_size<uint8_t>& a, const boost::scoped_array<uint16_t>& b) const;
+  double operator()(const uint16_t* a, const uint16_t* b, size_t numVectorElements) const; // Both uncompressed
 };
 
 struct L2DistanceObject {
   double operator()(const scoped_array_with_size<uint8_t>& a, const boost::scoped_array<uint16_t>& b) const;
+  double operator()(const uint16_t* a, const uint16_t* b, size_t numVectorElements) const; // Both uncompressed
 };
 
 class LSHTableBase {
   public:
     virtual ~LSHTableBase() {}
     virtual std::vector<std::pair<size_t, double> > query(size_t i) const = 0;
+
+    // Runs query() for each of the given vectors; results[n] corresponds to queries[n]
+    virtual void query_batch(const std::vector<size_t>& queries, std::vector<std::vector<std::pair<size_t, double> > >& results) const {
+      results.resize(queries.size());
+      for (size_t n = 0; n < queries.size(); ++n) {
+        results[n] = query(queries[n]);
+      }
+    }
 };
 
 template <typename HashFunctionGenerator, typename DistanceFunc>
@@ -289,31 +323,65 @@ class LSHTable: public LSHTableBase {
     }
   }
 
-  public:
-  std::vector<std::pair<size_t, double> > query(size_t i) const { // Pairs are vector number, distance
-    std::vector<std::pair<size_t, double> > clusterElements;
+  // Per-thread buffers reused across queries
+  struct QueryScratch {
+    boost::scoped_array<size_t> hashes;
+    boost::scoped_array<uint16_t> queryVector, candidateVector;
+    std::vector<size_t> bucketContents;
+    QueryScratch(size_t l, size_t numVectorElements):
+      hashes(new size_t[l]), queryVector(new uint16_t[numVectorElements]), candidateVector(new uint16_t[numVectorElements]) {}
+  };
+
+  void query_into(size_t i, QueryScratch& scratch, std::vector<std::pair<size_t, double> >& clusterElements) const {
+    clusterElements.clear();
     clusterElements.push_back(std::make_pair(i, 0));
     const VectorEntry& ve = vectors[i];
-    boost::scoped_array<size_t> hashes(new size_t[l]);
-    hashFunctions.compute_hashes(ve.compressedCounts, hashes);
-    std::vector<size_t> bucketContents;
+    hashFunctions.compute_hashes(ve.compressedCounts, scratch.hashes);
+    std::vector<size_t>& bucketContents = scratch.bucketContents;
+    bucketContents.clear();
     for (size_t hashNum = 0; hashNum < l; ++hashNum) { //Loop over hash tables
-      size_t bucketNum = hashes[hashNum];
+      size_t bucketNum = scratch.hashes[hashNum];
       hashTables.append_bucket_contents(hashNum, bucketNum, bucketContents);
     }
-    boost::scoped_array<uint16_t> uncompressedVectorI(new uint16_t[numVectorElements]);
-    decompressVector(ve.compressedCounts.get(), ve.compressedCounts.size(), uncompressedVectorI.get());
+    decompressVector(ve.compressedCounts.get(), ve.compressedCounts.size(), scratch.queryVector.get());
     // Remove duplicates to avoid distance computations
     std::sort(bucketContents.begin(), bucketContents.end());
     bucketContents.erase(std::unique(bucketContents.begin(), bucketContents.end()), bucketContents.end());
     for (size_t i = 0; i < bucketContents.size(); ++i) {
       size_t entry = bucketContents[i];
       const VectorEntry& ve2 = vectors[entry];
-      double dist = distance(ve2.compressedCounts, uncompressedVectorI);
+      // Decompress the candidate so the distance is one pass of the vectorized kernel over both dense vectors
+      decompressVector(ve2.compressedCounts.get(), ve2.compressedCounts.size(), scratch.candidateVector.get());
+      double dist = distance(scratch.candidateVector.get(), scratch.queryVector.get(), numVectorElements);
       if (dist > distBound) continue;
       clusterElements.push_back(std::make_pair(entry, dist));
     }
+  }
+
+  public:
+  std::vector<std::pair<size_t, double> > query(size_t i) const { // Pairs are vector number, distance
+    QueryScratch scratch(l, numVectorElements);
+    std::vector<std::pair<size_t, double> > clusterElements;
+    query_into(i, scratch, clusterElements);
     return clusterElements;
   }
+
+  // The queries are independent, so they are spread over threads when OpenMP is enabled
+  void query_batch(const std::vector<size_t>& queries, std::vector<std::vector<std::pair<size_t, double> > >& results) const {
+    results.resize(queries.size());
+    const int numQueries = queries.size();
+#if ROSE_GCC_OMP
+#pragma omp parallel
+#endif
+    {
+      QueryScratch scratch(l, numVectorElements);
+#if ROSE_GCC_OMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+      for (int n = 0; n < numQueries; ++n) {
+        query_into(queries[n], scratch, results[n]);
+      }
+    }
+  }
 };
 
@@ -16,6 +16,9 @@ double l2distanceSquared(const uint8_t compressedData[], size_t compressedDataSi
 size_t l1distanceC(const uint8_t compressedData[], const size_t compressedDataSize, const uint8_t otherVectorCompressedData[], const size_t otherVectorCompressedDataSize);
 double l2distanceSquaredC(const uint8_t compressedData[], const size_t compressedDataSize, const uint8_t otherVectorCompressedData[], const size_t otherVectorCompressedDataSize);
 void elementwiseMax(const uint8_t compressedData[], size_t compressedDataSize, uint16_t v[]);
+// Distances between uncompressed vectors of n elements; these use SSE2 when the compiler targets it
+uint64_t l1distanceDense(const uint16_t a[], const uint16_t b[], size_t n);
+uint64_t l2distanceSquaredDense(const uint16_t a[], const uint16_t b[], size_t n);
 size_t computeL1Hash(const uint8_t compressedData[], size_t compressedDataSize, size_t hashElementCount, const size_t indexes[], const size_t compareValues[], const size_t coeffs[], size_t moduloValue);
 
 #endif // VECTORCOMPRESSION_H
@@ -42,6 +42,10 @@ namespace AutoParallelization
   extern bool enable_diff; // an option to compare user-defined OpenMP pragmas to compiler generated ones.
   extern bool b_unique_indirect_index; // assume all arrays used as indirect indices has unique elements(no overlapping)
   extern bool enable_distance; // print out absolute dependence distance for a dependence relation preventing from parallelization
+  extern bool enable_profitability; // only parallelize loops whose estimated work is worth the overhead of a parallel region, choose schedule kinds
+  extern bool enable_multiversion; // guard a parallelized loop with a serial version instead of an if clause when the trip count is unknown
+  extern bool enable_collapse; // collapse a parallelized loop with its perfectly nested, rectangular and dependence-free inner loop
+  extern int par_threshold; // the minimum estimated work (in abstract operations) of a loop to be parallelized
 
   // Conduct necessary analyses on the project, can be called multiple times during program transformations. 
   bool initialize_analysis(SgProject* project=NULL,bool debug=false);
@@ -79,13 +83,21 @@ namespace AutoParallelization
 
   // Eliminate irrelevant dependencies for a loop node 'sg_node'
   // Save the remaining dependencies which prevent parallelization
+  // (of the loop at 'carry_level' of the nest in the dependence graph, 0 being sg_node itself)
   void DependenceElimination(SgNode* sg_node, LoopTreeDepGraph* depgraph, std::vector<DepInfo>&remain, OmpSupport::OmpAttribute* attribute, 
-       std::map<SgNode*, bool> & indirectTable, ArrayInterface* array_interface=0, ArrayAnnotation* annot=0);
+       std::map<SgNode*, bool> & indirectTable, ArrayInterface* array_interface=0, ArrayAnnotation* annot=0, int carry_level=0);
 
 #if 0 // refactored into the OmpSupport namespace
   //Generate and insert OpenMP pragmas according to OmpAttribute
   void generatedOpenMPPragmas(SgNode* node);
 #endif
+  // Estimate the cost of one iteration of a loop in abstract operations, using the loop body's AST only
+  // Inner loops with unknown trip counts are assumed to iterate a fixed number of times.
+  double EstimateIterationCost(SgForStatement* loop);
+
+  // Return true and the number of iterations if a canonical loop has a compile-time constant trip count
+  bool GetConstantTripCount(SgForStatement* loop, long& tripCount);
+
   //Parallelize an input loop at its outermost loop level, return true if successful
   bool ParallelizeOutermostLoop(SgNode* loop, ArrayInterface* array_interface, ArrayAnnotation* annot);
 
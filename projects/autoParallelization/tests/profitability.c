@@ -0,0 +1,58 @@
+/* Loops exercising the profitability analysis of autoPar
+ * (-rose:autopar:enable_profitability, -rose:autopar:multiversion, -rose:autopar:enable_collapse)
+ */
+#define N 1000
+
+double a[N][N], b[N][N], x[N], y[N];
+int len[N];
+
+/* too little work: stays serial */
+void small(void)
+{
+  int i;
+  for (i = 0; i < 16; i++)
+    x[i] = x[i] + 1.0;
+}
+
+/* unknown trip count: if (n > ...) clause or a serial version */
+void unknown(int n, double alpha)
+{
+  int i;
+  for (i = 0; i < n; i++)
+    y[i] = alpha * x[i] + y[i];
+}
+
+/* unsigned bounds: the runtime trip count test computes with signed values */
+void shifted(unsigned long lo, unsigned long hi)
+{
+  int i;
+  for (i = lo; i < hi; i++)
+    y[i] = 2.0 * y[i];
+}
+
+/* triangular loop nest: schedule (static,1) */
+void triangular(void)
+{
+  int i, j;
+  for (i = 0; i < N; i++)
+    for (j = 0; j <= i; j++)
+      a[i][j] = a[i][j] + b[j][i];
+}
+
+/* data dependent inner trip counts: schedule (dynamic) */
+void irregular(void)
+{
+  int i, j;
+  for (i = 0; i < N; i++)
+    for (j = 0; j < len[i]; j++)
+      b[i][j] = b[i][j] * 2.0;
+}
+
+/* perfectly nested rectangular loops: collapse (2) */
+void nested(int m)
+{
+  int i, j;
+  for (i = 0; i < m; i++)
+    for (j = 0; j < N; j++)
+      a[i][j] = a[i][j] + b[i][j];
+}
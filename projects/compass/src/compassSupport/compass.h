@@ -90,6 +90,15 @@ namespace Compass {
   //! Support for using SQLite as output data when run as batch
   extern bool UseDbOutput;
   extern std::string outputDbName;
+
+  //! Report the time spent in each checker that is run as part of the combined traversal
+  extern bool UseCheckerTiming;
+
+  //! Number of processes in which the files of the project are checked by the combined traversal (1 checks them serially)
+  extern int checkerJobs;
+
+  //! Directory of the incremental result cache (the cache is not used when this is empty)
+  extern std::string resultCacheDir;
 #ifdef HAVE_SQLITE3
   extern sqlite3x::sqlite3_connection con;
 #endif
@@ -149,6 +158,9 @@ namespace Compass {
     /// Get the value of a parameter
     std::string operator[](const std::string& name) const
       throw (ParameterNotFoundException);
+
+    // The result cache hashes all the parameters
+    friend class ResultCache;
   };
 
   std::string findParameterFile();
@@ -277,6 +289,17 @@ namespace Compass {
     virtual ~AstSimpleProcessingWithRunFunction() {}
     virtual void run(SgNode*)=0;
     virtual void visit(SgNode* n)=0;
+
+    /// True if run() is nothing more than a preorder traversal of its argument, so that visit() can
+    /// instead be called from a traversal combined with other checkers (see runCheckers()).
+    /// Checkers that use a postorder traversal or do extra work in run() must return false.
+    virtual bool isCombinable() const { return true; }
+
+    /// True if the violations found in each file depend only on that file, so that the files can be
+    /// checked by the combined traversal in separate processes (see --compass:jobs).  Checkers that
+    /// keep state from one file to the next must return false; they are run over the whole project
+    /// in the main process.
+    virtual bool isFileLocal() const { return true; }
   };
 
 
@@ -378,6 +401,54 @@ namespace Compass {
 #endif
   };
 
+  /// An output object which holds the violations of one checker until they are
+  /// passed on to another output object.  Each checker in a combined traversal
+  /// has its own buffer, so that the violations are still output in checker
+  /// order even though the checkers' visits are interleaved.
+  class BufferedOutputObject: public OutputObject
+  {
+  public:
+    virtual void addOutput(OutputViolationBase* theOutput) { outputList.push_back(theOutput); }
+
+    /// Pass the buffered violations on to output (in the order they were added) and empty the buffer
+    void flush(OutputObject* output);
+  };
+
+  /// A persistent cache of the violations reported for each source file, kept in the
+  /// directory given with --compass:cache.  The entry of a source file records a hash of
+  /// the file, of every header it includes, and of the parameters and command line it
+  /// was checked with.  If none of these has changed then the violations are replayed
+  /// from the entry and the file is neither parsed nor checked again.
+  class ResultCache
+  {
+  public:
+    ResultCache(const std::string& directory, const Parameters& params,
+                const Rose_STL_Container<std::string>& commandLineArray);
+
+    /// Output the cached violations of each source file on the command line whose entry
+    /// is still valid and remove those files from the command line.  Returns the number
+    /// of files whose violations were replayed.
+    size_t replay(Rose_STL_Container<std::string>& commandLineArray, std::ostream& stream);
+
+    /// Write the entries for the source files of the project, given the violations that
+    /// were output for them.
+    void update(SgProject* project, OutputObject* output);
+
+  private:
+    std::string entryName(const std::string& sourceFile) const;
+    bool readEntry(const std::string& sourceFile, std::vector<std::string>& violations) const;
+    bool writeEntry(const std::string& sourceFile, const std::set<std::string>& includedFiles,
+                    const std::vector<std::string>& violations) const;
+
+    std::string directory;
+
+    // Hash of the parameters and of the command line without its source files
+    std::string configuration;
+
+    // Hash of each source file on the command line, taken before it was parsed
+    std::map<std::string, std::string> sourceFileHashes;
+  };
+
   // ToolGear Support
   void outputTgui( std::string & tguiXML, std::vector<const Compass::Checker*> & checkers, Compass::OutputObject *output );
   // tps (18Dec2008) : Added a guard because javaport testcase brakes on this
@@ -396,6 +467,18 @@ namespace Compass {
 
   /// Run a checker and its prerequisites
   void runCheckerAndPrereqs(const Checker* checker, SgProject* proj, Parameters params, OutputObject* output);
+
+  /// Run the checkers (but not their prerequisites) on the project.  The
+  /// checkers whose traversals are combinable are run together in a single
+  /// traversal of the AST; the others are run one at a time.  When
+  /// checkerJobs is greater than one, each file is traversed in a process of
+  /// its own, up to checkerJobs at a time, and the violations are merged back
+  /// in file order.
+  /// Violations are passed to output in the same order as if each checker had
+  /// been run in turn.  None of the checkers may be null.  Returns the name of
+  /// each checker that failed along with the reason.
+  std::vector<std::pair<std::string, std::string> >
+  runCheckers(const std::vector<const Checker*>& checkers, SgProject* proj, Parameters params, OutputObject* output);
 }
 
 #endif // ROSE_COMPASS_H
@@ -14,7 +14,7 @@ public:
     /** Creates an empty process containing no threads. */
     explicit RSIM_Process(RSIM_Simulator *simulator)
         : simulator(simulator), tracing_file(NULL), tracing_flags(0),
-          brk_va(0), mmap_start(0x40000000ul), mmap_recycle(false), disassembler(NULL), futexes(NULL),
+          brk_va(0), mmap_start(0x40000000ul), mmap_recycle(false), disassembler(NULL), bcache_maxsize(0), bcache_generation(0), futexes(NULL),
           interpretation(NULL), ep_orig_va(0), ep_start_va(0),
           terminated(false), termination_status(0), core_flags(0), btrace_file(NULL),
           vdso_mapped_va(0), vdso_entry_va(0),
@@ -24,6 +24,7 @@ public:
     }
 
     ~RSIM_Process() {
+        invalidate_all_blocks();
         delete futexes;
     }
 
@@ -196,16 +197,23 @@ public:
 
     /** Returns the memory map for the simulated process.  MemoryMap is not thread safe [as of 2011-03-31], so all access to
      *  the map should be protected by the process-wide read-write lock returned by the rwlock() method.
-     * @{ */
-    MemoryMap& get_memory() {
+     *
+     *  The map is read-only.  Specimen memory and its mappings are changed only through the mem_*() methods (mem_write(),
+     *  mem_map(), mem_insert(), mem_erase(), etc.), which invalidate the translated blocks that the change affects. */
+    const MemoryMap& get_memory() const {
         assert(!map_stack.empty());
         return map_stack.back().first;
     }
-    const MemoryMap& get_memory() const {
+
+private:
+    /* The same map as get_memory(), but modifiable. Whoever changes specimen memory or its mappings through this map must
+     * also invalidate the affected translated blocks. */
+    MemoryMap& get_writable_memory() {
         assert(!map_stack.empty());
         return map_stack.back().first;
     }
-    /** @} */
+
+public:
 
     /** Add a memory mapping to a specimen.  The new mapping starts at specimen address @p va (zero causes this method to
      *  choose an appropriate address) for @p size bytes.  The @p rose_perms are the MemoryMap::Protection bits, @p flags are
@@ -215,6 +223,19 @@ public:
      *  Thread safety:  This method is thread safe; it can be invoked on a single object by multiple threads concurrently. */
     rose_addr_t mem_map(rose_addr_t va, size_t size, unsigned rose_perms, unsigned flags, size_t offset, int fd);
 
+    /** Maps a segment into the specimen address space, replacing whatever was mapped at those addresses.  Unlike mem_map(),
+     *  the segment's memory has already been obtained by the caller (e.g., a System V shared memory segment attached by
+     *  shmat(), or a buffer used by an analysis) and the mmap free-space search is not affected.
+     *
+     *  Thread safety:  This method is thread safe; it can be invoked on a single object by multiple threads concurrently. */
+    void mem_insert(const Extent&, const MemoryMap::Segment&);
+
+    /** Removes the specified addresses from the specimen address space.  Unlike mem_unmap(), the underlying memory is not
+     *  unmapped from the simulator; it belongs to whoever inserted it with mem_insert().
+     *
+     *  Thread safety:  This method is thread safe; it can be invoked on a single object by multiple threads concurrently. */
+    void mem_erase(const Extent&);
+
     /** Set the process brk value and adjust the specimen's memory map accordingly.  The return value is either a negative
      *  error number (such as -ENOMEM) or the new brk value.  The optional @p mesg pointer will be used to show the memory map
      *  after it is adjusted.
@@ -251,11 +272,14 @@ public:
      *  Thread safety:  This method is thread safe; it can be invoked on a single object by multiple threads concurrently. */
     bool mem_is_mapped(rose_addr_t va) const;
 
-    /** Returns the memory address in ROSE where the specified specimen address is located.
+    /** Returns the memory address in ROSE where the specified specimen address is located.  The memory must not be written
+     *  through the returned address because translated blocks would not notice the change; use mem_write() instead.  If the
+     *  caller does something that lets the host change the memory (such as msync() with MS_INVALIDATE) then it must also
+     *  call invalidate_blocks() for those addresses.
      *
      *  Thread safety: This method is thread safe; it can be invoked on a single object by multiple threads
      *  concurrently. However, the address that is returned might be unmapped before the caller can do anything with it. */
-    void *my_addr(uint32_t va, size_t size);
+    const void *my_addr(uint32_t va, size_t size);
 
     /** Does the opposite, more or less, of my_addr(). Return a specimen virtual address that maps to the specified address in
      *  the simulator.  There may be more than one, in which case we return the lowest.
@@ -395,6 +419,100 @@ private:
     Disassembler *disassembler;                 /**< Disassembler to use for obtaining instructions */
     Disassembler::InstructionMap icache;        /**< Cache of disassembled instructions */
 
+public:
+    /** A straight-line run of instructions decoded once and then executed many times.  A block starts at whatever address
+     *  execution reached and extends up to and including the first instruction that terminates a basic block (or until
+     *  MAX_BLOCK_INSNS instructions).  Blocks are chained to the blocks at their fall-through and direct branch target
+     *  addresses the first time control flows there, so a thread following a hot path does not need to look anything up.
+     *
+     *  When the memory under a block changes, the block is marked invalid, removed from the cache, and its chain pointers are
+     *  cleared; threads notice this at the next instruction boundary.  Blocks are reference counted: the cache, each chain
+     *  pointer, and each thread's current block hold a reference, so a block that a thread is still executing stays alive
+     *  until the thread moves on.  The block is deleted when its last reference is released (the instructions it contains
+     *  belong to the instruction cache and are not deleted). */
+    struct TranslatedBlock {
+        TranslatedBlock(rose_addr_t va)
+            : va(va), fallthrough_va(va), target_va(0), has_target(false), fallthrough(NULL), target(NULL), valid(true),
+              nrefs(1) {}
+
+        rose_addr_t va;                                 /**< Address of first instruction. */
+        std::vector<SgAsmx86Instruction*> insns;        /**< Instructions in execution order. */
+        rose_addr_t fallthrough_va;                     /**< Address following the last instruction. */
+        rose_addr_t target_va;                          /**< Direct branch target of the last instruction if has_target. */
+        bool has_target;                                /**< True if the last instruction has a known branch target. */
+        TranslatedBlock *fallthrough;                   /**< Chained block at fallthrough_va, or null if not followed yet. */
+        TranslatedBlock *target;                        /**< Chained block at target_va, or null if not followed yet. */
+        volatile bool valid;                            /**< Cleared when specimen memory under the block changes. */
+        int nrefs;                                      /**< Reference count; see acquire_block() and release_block(). */
+
+        /** Extent of specimen memory occupied by the block's instructions. */
+        Extent extent() const {
+            return Extent(va, fallthrough_va-va);
+        }
+    };
+
+    /** Maximum number of instructions in a TranslatedBlock. */
+    static const size_t MAX_BLOCK_INSNS = 64;
+
+private:
+    typedef std::map<rose_addr_t, TranslatedBlock*> BlockCache;
+    BlockCache bcache;                          /**< Valid translated blocks by starting address. */
+    ExtentMap bcache_extents;                   /**< Specimen addresses occupied by translated blocks (maybe a superset). */
+    size_t bcache_maxsize;                      /**< Largest extent size of any block, bounds the search in invalidate_blocks() */
+    size_t bcache_generation;                   /**< Incremented by every invalidation. */
+
+public:
+    /** Returns the translated block starting at the specified address, decoding it if necessary.  Decoding goes through
+     *  get_instruction(), so the first instruction might throw a Disassembler::Exception just as it would have there; a
+     *  failure to decode a subsequent instruction just ends the block early.  The returned block has been acquired on behalf
+     *  of the caller, who must eventually release it with release_block().
+     *
+     *  Thread safety:  This method is thread safe; it can be invoked on a single object by multiple threads concurrently. */
+    TranslatedBlock *get_block(rose_addr_t va);
+
+    /** Returns the block to which control flows from @p prev when execution continues at @p va.  If @p va is the
+     *  fall-through address or direct branch target of @p prev then the chained block is used (and chained if not yet done),
+     *  otherwise this is the same as get_block().  As with get_block(), the returned block has been acquired on behalf of the
+     *  caller; the caller's reference to @p prev is not affected.
+     *
+     *  Thread safety:  This method is thread safe; it can be invoked on a single object by multiple threads concurrently. */
+    TranslatedBlock *next_block(TranslatedBlock *prev, rose_addr_t va);
+
+    /** Adds a reference to a translated block.  The caller must already hold a reference, or must hold the process lock while
+     *  reading the block from the cache or from a chain pointer.
+     *
+     *  Thread safety:  This method is thread safe. */
+    static void acquire_block(TranslatedBlock *block) {
+        __sync_add_and_fetch(&block->nrefs, 1);
+    }
+
+    /** Removes a reference from a translated block, deleting the block when the last reference is removed.  The @p block
+     *  may be null, in which case this is a no-op.
+     *
+     *  Thread safety:  This method is thread safe. */
+    static void release_block(TranslatedBlock *block);
+
+    /** Invalidates all translated blocks that overlap the specified specimen addresses.  This is called automatically when
+     *  specimen memory is written through mem_write(), when memory is mapped, unmapped, or has its protection changed, and
+     *  when a memory transaction is rolled back.  It must be called explicitly when specimen memory changes some other way,
+     *  such as through a simulator address returned by my_addr() or through a buffer inserted with mem_insert().
+     *
+     *  Thread safety:  This method is thread safe; it can be invoked on a single object by multiple threads concurrently. */
+    void invalidate_blocks(const Extent&);
+
+    /** Invalidates all translated blocks.
+     *
+     *  Thread safety:  This method is thread safe; it can be invoked on a single object by multiple threads concurrently. */
+    void invalidate_all_blocks();
+
+private:
+    /* Same as invalidate_blocks() but the caller must already hold the write lock. */
+    void invalidate_blocks_nolock(const Extent&);
+
+    /* Marks a block invalid and releases its chain references. The caller must hold the write lock and must still hold the
+     * cache's reference to the block. */
+    void invalidate_block_nolock(TranslatedBlock*);
+
 public:
     /** Disassembles the instruction at the specified virtual address. For efficiency, instructions are cached by the
      *  process. Instructions are removed from the cache (but not deleted) when the memory at the instruction address changes.
@@ -17,7 +17,7 @@ public:
      *  thread that will be simulating the speciment's thread described by this object. */
     RSIM_Thread(RSIM_Process *process)
         : process(process), my_tid(-1),
-          mesg_prefix(this), report_interval(10.0),
+          mesg_prefix(this), report_interval(10.0), cur_block(NULL), cur_block_idx(0),
           policy(this), semantics(policy),
           robust_list_head_va(0), clear_child_tid(0) {
         real_thread = pthread_self();
@@ -542,14 +542,14 @@ private:
      *
      *  Upon successful return, val_ptr will point to the address in simulator memory where the futex value is stored.  This
      *  means that the specimen futex is required to occupy a single region of memory--it cannot span two different mapped
-     *  regions.
+     *  regions.  The value must only be read through val_ptr; see RSIM_Process::my_addr().
      *
      *  Returns zero on failure, non-zero on success.
      *
      *  Thread safety:  This method is not thread safe. We are assuming that the calling function has already surrounded this
      *  call with a mutex that protects this function from being entered concurrently by any other thread of the calling
      *  process. */
-    rose_addr_t futex_key(rose_addr_t va, uint32_t **val_ptr);
+    rose_addr_t futex_key(rose_addr_t va, const uint32_t **val_ptr);
     
 
     /**************************************************************************************************************************
@@ -564,9 +564,18 @@ public:
 
     /** Returns instruction at current IP, disassembling it if necessary, and caching it.  Since the simulated memory belongs
      *  to the entire RSIM_Process, all this method does is obtain the thread's current instruction address and then has the
-     *  RSIM_Process disassemble the instruction. */
+     *  RSIM_Process disassemble the instruction.
+     *
+     *  Instructions are obtained a whole block at a time (see RSIM_Process::TranslatedBlock) and the thread remembers where it
+     *  is in the current block, so that while execution proceeds sequentially or along chained branches no lookup is
+     *  necessary.  If memory callbacks are registered then every instruction is fetched through RSIM_Process::get_instruction()
+     *  instead, so that the callbacks see each instruction fetch. */
     SgAsmx86Instruction *current_insn();
 
+private:
+    RSIM_Process::TranslatedBlock *cur_block;   /**< Block containing the most recently fetched instruction (referenced), or null. */
+    size_t cur_block_idx;                       /**< Index of the most recently fetched instruction in cur_block. */
+
 
     /**************************************************************************************************************************
      *                                  Dynamic Linking
@@ -0,0 +1,67 @@
+/* Specimen that rewrites its own code.  The simulator caches translated blocks, so each rewrite must invalidate the block
+ * that was executed before and the new code must be executed instead.  The code is changed both by storing into an existing
+ * executable page and by unmapping the page and mapping a new one at the same address.  Exits with zero status on success. */
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#define NITERS 1000
+
+typedef int (*Function)(void);
+
+/* Writes "mov eax, VALUE; ret" at the specified address. */
+static void
+emit(unsigned char *code, int value)
+{
+    code[0] = 0xb8;
+    memcpy(code+1, &value, 4);
+    code[5] = 0xc3;
+}
+
+static unsigned char *
+map_code(void *where)
+{
+    void *page = mmap(where, 4096, PROT_READ|PROT_WRITE|PROT_EXEC, MAP_PRIVATE|MAP_ANONYMOUS|(where?MAP_FIXED:0), -1, 0);
+    if (MAP_FAILED==page) {
+        perror("mmap");
+        return NULL;
+    }
+    return page;
+}
+
+int
+main()
+{
+    unsigned char *code = map_code(NULL);
+    int i, nerrors = 0;
+    if (!code)
+        return 1;
+
+    /* Rewrite the code in place. */
+    for (i=0; i<NITERS; ++i) {
+        emit(code, i);
+        int got = ((Function)code)();
+        if (got!=i) {
+            fprintf(stderr, "store: expected %d but got %d\n", i, got);
+            ++nerrors;
+        }
+    }
+
+    /* Replace the page holding the code. */
+    for (i=0; i<NITERS; ++i) {
+        if (-1==munmap(code, 4096)) {
+            perror("munmap");
+            return 1;
+        }
+        if (code!=map_code(code))
+            return 1;
+        emit(code, -i);
+        int got = ((Function)code)();
+        if (got!=-i) {
+            fprintf(stderr, "remap: expected %d but got %d\n", -i, got);
+            ++nerrors;
+        }
+    }
+
+    return nerrors ? 1 : 0;
+}
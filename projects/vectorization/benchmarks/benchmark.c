@@ -0,0 +1,139 @@
+/*
+  Benchmark driver for the vectorization.
+
+  Usage: benchmark [REFERENCE]
+
+  Each kernel of kernels.c is executed REPEAT times, and its time and checksum are printed on one line.
+  With the output of the scalar version as REFERENCE, the checksums of the vectorized version are compared 
+  with the reference, and the speedups are reported.  The exit status is 1 if a checksum differs.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/time.h>
+
+#define N 4099
+#define REPEAT 20000
+#define TOLERANCE 1e-3
+
+extern float a[N];
+extern float b[N];
+extern float c[N];
+extern int idx[N];
+extern double x[N];
+extern double y[N];
+
+extern void saxpy(float);
+extern float sdot();
+extern void stencil();
+extern void gather();
+extern void daxpy(double);
+
+static double now()
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + 1e-6 * tv.tv_usec;
+}
+
+static void initialize()
+{
+  int i;
+  for (i = 0; i < N; i++)
+  {
+    a[i] = (float)(i % 17) / 17;
+    b[i] = (float)(i % 13) / 13;
+    c[i] = 0;
+    idx[i] = (i * 7) % N;
+    x[i] = (double)(i % 11) / 11;
+    y[i] = 0;
+  }
+}
+
+static double checksum_float(float* array)
+{
+  double sum = 0;
+  int i;
+  for (i = 0; i < N; i++)
+    sum += array[i];
+  return sum;
+}
+
+static double checksum_double(double* array)
+{
+  double sum = 0;
+  int i;
+  for (i = 0; i < N; i++)
+    sum += array[i];
+  return sum;
+}
+
+static void run(const char* name, int kernel, FILE* reference, int* nerrors)
+{
+  double result = 0;
+  double start, elapsed;
+  int r;
+  initialize();
+  start = now();
+  for (r = 0; r < REPEAT; r++)
+  {
+    switch (kernel)
+    {
+      case 0: saxpy(1.5f); break;
+      case 1: result += sdot(); break;
+      case 2: stencil(); break;
+      case 3: gather(); break;
+      case 4: daxpy(1.0e-4); break;
+    }
+  }
+  elapsed = now() - start;
+  if (kernel == 4)
+    result = checksum_double(y);
+  else if (kernel != 1)
+    result = checksum_float(c);
+
+  if (reference == NULL)
+    printf("%s %f %.10g\n", name, elapsed, result);
+  else
+  {
+    char refName[64];
+    double refElapsed, refResult;
+    int ok;
+    if (fscanf(reference, "%63s %lf %lf", refName, &refElapsed, &refResult) != 3 || strcmp(refName, name) != 0)
+    {
+      fprintf(stderr, "%s: no reference result\n", name);
+      ++*nerrors;
+      return;
+    }
+    ok = fabs(result - refResult) <= TOLERANCE * fabs(refResult);
+    printf("%-8s scalar %8.4fs  SIMD %8.4fs  speedup %5.2f  %s\n", name, refElapsed, elapsed, 
+           refElapsed / elapsed, ok ? "ok" : "checksum differs");
+    if (!ok)
+      ++*nerrors;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  FILE* reference = NULL;
+  int nerrors = 0;
+  if (argc > 2)
+  {
+    fprintf(stderr, "usage: %s [REFERENCE]\n", argv[0]);
+    return 1;
+  }
+  if (argc == 2 && (reference = fopen(argv[1], "r")) == NULL)
+  {
+    fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[1]);
+    return 1;
+  }
+  run("saxpy", 0, reference, &nerrors);
+  run("sdot", 1, reference, &nerrors);
+  run("stencil", 2, reference, &nerrors);
+  run("gather", 3, reference, &nerrors);
+  run("daxpy", 4, reference, &nerrors);
+  if (reference != NULL)
+    fclose(reference);
+  return nerrors ? 1 : 0;
+}
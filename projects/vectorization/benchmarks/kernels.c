@@ -0,0 +1,62 @@
+/*
+  Kernels of the vectorization benchmark.
+  benchmark.c runs them from the original source and from the source translated by the vectorization.
+
+  N is not a multiple of the vector factor, and stencil starts from 1,
+  so that the prologue and remainder loops are executed.
+*/
+#define N 4099
+
+float a[N];
+float b[N];
+float c[N];
+int idx[N];
+double x[N];
+double y[N];
+
+// c = alpha * a + b
+void saxpy(float alpha)
+{
+  for (int i=0;i<N;i++)
+  {
+    c[i] = alpha * a[i] + b[i];
+  }
+}
+
+// sum reduction of a * b
+float sdot()
+{
+  float sum = 0;
+  for (int i=0;i<N;i++)
+  {
+    sum += a[i] * b[i];
+  }
+  return sum;
+}
+
+// 3-point stencil with unaligned references
+void stencil()
+{
+  for (int i=1;i<N-1;i++)
+  {
+    c[i] = 0.25f * (a[i-1] + a[i+1]) + 0.5f * a[i];
+  }
+}
+
+// indirect references
+void gather()
+{
+  for (int i=0;i<N;i++)
+  {
+    c[i] = a[idx[i]] * b[i];
+  }
+}
+
+// y = alpha * x + y in double precision
+void daxpy(double alpha)
+{
+  for (int i=0;i<N;i++)
+  {
+    y[i] += alpha * x[i];
+  }
+}
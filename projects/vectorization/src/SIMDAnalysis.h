@@ -4,6 +4,11 @@
 #include "rose.h"
 #include "sageBuilder.h"
 #include "DefUseAnalysis.h"
+#include <map>
+#include <set>
+
+class ArrayInterface;
+class ArrayAnnotation;
 
 namespace SIMDAnalysis
 {
@@ -16,6 +21,31 @@ namespace SIMDAnalysis
 //  Check if the loop has stride distance 1  
   bool isStrideOneLoop(SgNode*);
 
+//  Check if the expression is part of an array subscript within the root
+  bool isInSubscript(SgNode*, SgNode*);
+//  Check if the array reference is not the base of another (multi-dimensional) array reference
+  bool isOutermostArrayRef(SgPntrArrRefExp*);
+
+//  The way an array reference is accessed by consecutive iterations of the vectorized loop
+  enum SIMDAccessType
+  {
+    SIMD_INVARIANT,   // same element in every iteration:  a[j]
+    SIMD_ALIGNED,     // unit stride, aligned after peeling: a[i], b[j][i]
+    SIMD_UNALIGNED,   // unit stride with an offset, or through a pointer: a[i+1], p[i]
+    SIMD_GATHER       // any other access: a[2*i], a[idx[i]], b[i][j]
+  };
+//  Classify an array reference with respect to the loop index.  The integer argument is the vector factor.
+  SIMDAccessType getAccessType(SgPntrArrRefExp*, SgInitializedName*, int);
+//  Collect the scalars written in the loop: reduction variables and private temporaries.
+//  Return false if the loop writes any other scalar.
+  bool getScalarVariables(SgForStatement*, std::map<SgInitializedName*, VariantT>&, std::set<SgInitializedName*>&);
+//  Check if every statement of the innermost loop can be translated, and return the element type 
+//  of its vector operations (float, double or int).  Return NULL if the loop can not be vectorized.
+  SgType* getVectorizableType(SgForStatement*, std::map<SgInitializedName*, VariantT>&, std::set<SgInitializedName*>&);
+//  Check that no dependence carried by the loop prevents executing VF consecutive iterations together.
+  bool isDependenceFree(SgForStatement*, int, const std::map<SgInitializedName*, VariantT>&, 
+                        const std::set<SgInitializedName*>&, ArrayInterface*, ArrayAnnotation*);
+
 }
 
 #endif // _SIMD_ANALYSIS_H
@@ -4,7 +4,17 @@
 #ifndef LIB_SIMD_H 
 #define LIB_SIMD_H
 
+/*
+The target is selected by the compiler flags: -mavx selects AVX, SSE2 is the default.
+Define USE_SSE, USE_AVX or USE_IBM to select it explicitly.
+*/
+#if !defined(USE_SSE) && !defined(USE_AVX) && !defined(USE_IBM)
+#ifdef __AVX__
+#define USE_AVX 1
+#else
 #define USE_SSE 1
+#endif
+#endif
 
 /*
 The suffix implies the data type.
@@ -21,7 +31,8 @@ typedef  __m128i  __SIMDi;
 typedef  __m128d  __SIMDd; 
 
 #elif defined USE_AVX
-#include <avxintrin.h>
+// The integer operations on __m256i require AVX2 (-mavx2), otherwise they are performed on both 128-bit halves.
+#include <immintrin.h>
 typedef  __m256   __SIMD; 
 typedef  __m256i  __SIMDi; 
 typedef  __m256d  __SIMDd; 
@@ -41,6 +52,15 @@ _pd means "packed double-precision"
 _epi32 is for "packed integer" 
 */
 
+#ifdef ROSE_SIMD_INLINE
+/*
+  The runtime library is compiled with the translated code, so that the compiler can inline the SIMD functions.
+  The translated code has to be compiled with the same target flags, e.g. -msse2 or -mavx.
+*/
+#define _SIMD_FUNCTION static inline
+#include "rosesimd.c"
+#else
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -81,7 +101,33 @@ extern __SIMD  _SIMD_splats_ps(float);
 extern __SIMDd  _SIMD_splats_pd(double);
 extern __SIMDi  _SIMD_splats_epi32(int);
 
+// Unaligned load:  a[i+1] ==> _SIMD_loadu_ps(&a[i+1])
+extern __SIMD  _SIMD_loadu_ps(float*);
+extern __SIMDd _SIMD_loadu_pd(double*);
+extern __SIMDi _SIMD_loadu_epi32(int*);
+
+// Unaligned store:  a[i+1] = b  ==> _SIMD_storeu_ps(&a[i+1], b)
+extern void _SIMD_storeu_ps(float*, __SIMD);
+extern void _SIMD_storeu_pd(double*, __SIMDd);
+extern void _SIMD_storeu_epi32(int*, __SIMDi);
+
+// Sum of all values packed in the SIMD operand, the result of a sum reduction
+extern float  _SIMD_reduce_add_ps(__SIMD);
+extern double _SIMD_reduce_add_pd(__SIMDd);
+extern int    _SIMD_reduce_add_epi32(__SIMDi);
+
+// Product of all values packed in the SIMD operand, the result of a product reduction
+extern float  _SIMD_reduce_mul_ps(__SIMD);
+extern double _SIMD_reduce_mul_pd(__SIMDd);
+extern int    _SIMD_reduce_mul_epi32(__SIMDi);
+
+// The last value packed in the SIMD operand, the value of a private variable after the loop
+extern float  _SIMD_last_ps(__SIMD);
+extern double _SIMD_last_pd(__SIMDd);
+extern int    _SIMD_last_epi32(__SIMDi);
+
 #ifdef __cplusplus
 }
 #endif
+#endif  // ROSE_SIMD_INLINE
 #endif  // LIB_SIMD_H
@@ -6,102 +6,120 @@
 
   This file provides runtime library functions.  
   The functions will map to the SIMD intrinsic functions used in different compilers. 
+  With ROSE_SIMD_INLINE, rose_simd.h includes this file to define the functions as static inline functions.
 */
 
 //#include "rose_config.h"
 #include "rose_simd.h"
 
-#define USE_SSE 1
+#ifndef _SIMD_FUNCTION
+#define _SIMD_FUNCTION
+#endif
+
+#if defined USE_AVX && !defined __AVX2__
+// Without AVX2, the integer operation is performed on the two 128-bit halves of the operands.
+#define _SIMD_AVX_EPI32(op,a,b) \
+  _mm256_insertf128_si256(_mm256_castsi128_si256(op(_mm256_castsi256_si128(a),_mm256_castsi256_si128(b))), \
+                          op(_mm256_extractf128_si256(a,1),_mm256_extractf128_si256(b,1)),1)
+#endif
 
-__SIMD _SIMD_add_ps(__SIMD a, __SIMD b)
+_SIMD_FUNCTION __SIMD _SIMD_add_ps(__SIMD a, __SIMD b)
 {
 #ifdef  USE_SSE
   return _mm_add_ps(a,b);
 #elif defined USE_AVX
-  return _m256_add_ps(a,b);
+  return _mm256_add_ps(a,b);
 #elif defined USE_IBM
   return vec_add(a,b);
 #endif
 }
 
-__SIMDd _SIMD_add_pd(__SIMDd a, __SIMDd b)
+_SIMD_FUNCTION __SIMDd _SIMD_add_pd(__SIMDd a, __SIMDd b)
 {
 #ifdef  USE_SSE
   return _mm_add_pd(a,b);
 #elif defined USE_AVX
-  return _m256_add_ps(a,b);
+  return _mm256_add_pd(a,b);
 #elif defined USE_IBM
   return vec_add(a,b);
 #endif
 }
 
-__SIMDi _SIMD_add_epi32(__SIMDi a, __SIMDi b)
+_SIMD_FUNCTION __SIMDi _SIMD_add_epi32(__SIMDi a, __SIMDi b)
 {
 #ifdef  USE_SSE
   return _mm_add_epi32(a,b);
 #elif defined USE_AVX
-  return _m256_add_ps(a,b);
+  #ifdef __AVX2__
+  return _mm256_add_epi32(a,b);
+#else
+  return _SIMD_AVX_EPI32(_mm_add_epi32,a,b);
+#endif
 #elif defined USE_IBM
   return vec_add(a,b);
 #endif
 }
 
-__SIMD _SIMD_sub_ps(__SIMD a, __SIMD b)
+_SIMD_FUNCTION __SIMD _SIMD_sub_ps(__SIMD a, __SIMD b)
 {
 #ifdef  USE_SSE
   return _mm_sub_ps(a,b);
 #elif defined USE_AVX
-  return _m256_sub_ps(a,b);
+  return _mm256_sub_ps(a,b);
 #elif defined USE_IBM
   return vec_sub(a,b);
 #endif
 }
 
-__SIMDd _SIMD_sub_pd(__SIMDd a, __SIMDd b)
+_SIMD_FUNCTION __SIMDd _SIMD_sub_pd(__SIMDd a, __SIMDd b)
 {
 #ifdef  USE_SSE
   return _mm_sub_pd(a,b);
 #elif defined USE_AVX
-  return _m256_sub_ps(a,b);
+  return _mm256_sub_pd(a,b);
 #elif defined USE_IBM
   return vec_sub(a,b);
 #endif
 }
 
-__SIMDi _SIMD_sub_epi32(__SIMDi a, __SIMDi b)
+_SIMD_FUNCTION __SIMDi _SIMD_sub_epi32(__SIMDi a, __SIMDi b)
 {
 #ifdef  USE_SSE
   return _mm_sub_epi32(a,b);
 #elif defined USE_AVX
-  return _m256_sub_ps(a,b);
+  #ifdef __AVX2__
+  return _mm256_sub_epi32(a,b);
+#else
+  return _SIMD_AVX_EPI32(_mm_sub_epi32,a,b);
+#endif
 #elif defined USE_IBM
   return vec_sub(a,b);
 #endif
 }
 
-__SIMD _SIMD_mul_ps(__SIMD a, __SIMD b)
+_SIMD_FUNCTION __SIMD _SIMD_mul_ps(__SIMD a, __SIMD b)
 {
 #ifdef  USE_SSE
   return _mm_mul_ps(a,b);
 #elif defined USE_AVX
-  return _m256_mul_ps(a,b);
+  return _mm256_mul_ps(a,b);
 #elif defined USE_IBM
   return vec_mul(a,b);
 #endif
 }
 
-__SIMDd _SIMD_mul_pd(__SIMDd a, __SIMDd b)
+_SIMD_FUNCTION __SIMDd _SIMD_mul_pd(__SIMDd a, __SIMDd b)
 {
 #ifdef  USE_SSE
   return _mm_mul_pd(a,b);
 #elif defined USE_AVX
-  return _m256_mul_ps(a,b);
+  return _mm256_mul_pd(a,b);
 #elif defined USE_IBM
   return vec_mul(a,b);
 #endif
 }
 
-__SIMDi _SIMD_mul_epi32(__SIMDi a, __SIMDi b)
+_SIMD_FUNCTION __SIMDi _SIMD_mul_epi32(__SIMDi a, __SIMDi b)
 {
 #ifdef  USE_SSE
 #ifdef __SSE4_1__  // modern CPU - use SSE 4.1
@@ -112,33 +130,38 @@ __SIMDi _SIMD_mul_epi32(__SIMDi a, __SIMDi b)
     return _mm_unpacklo_epi32(_mm_shuffle_epi32(tmp1, _MM_SHUFFLE (0,0,2,0)), _mm_shuffle_epi32(tmp2, _MM_SHUFFLE (0,0,2,0))); /* shuffle results to [63..0] and pack */
 #endif
 #elif defined USE_AVX
-  return _m256_mul_ps(a,b);
+#ifdef __AVX2__
+  return _mm256_mullo_epi32(a,b);
+#else
+  return _SIMD_AVX_EPI32(_mm_mullo_epi32,a,b);
+#endif
 #elif defined USE_IBM
   return vec_mul(a,b);
 #endif
 }
 
-__SIMD _SIMD_div_ps(__SIMD a, __SIMD b)
+_SIMD_FUNCTION __SIMD _SIMD_div_ps(__SIMD a, __SIMD b)
 {
 #ifdef  USE_SSE
   return _mm_div_ps(a,b);
 #elif defined USE_AVX
-  return _m256_div_ps(a,b);
+  return _mm256_div_ps(a,b);
 #elif defined USE_IBM
   return vec_div(a,b);
 #endif
 }
 
-__SIMDd _SIMD_div_pd(__SIMDd a, __SIMDd b)
+_SIMD_FUNCTION __SIMDd _SIMD_div_pd(__SIMDd a, __SIMDd b)
 {
 #ifdef  USE_SSE
   return _mm_div_pd(a,b);
 #elif defined USE_AVX
-  return _m256_div_ps(a,b);
+  return _mm256_div_pd(a,b);
 #elif defined USE_IBM
   return vec_div(a,b);
 #endif
 }
+
 /*
 __SIMDi _SIMD_div_epi32(__SIMDi a, __SIMDi b)
 {
@@ -151,101 +174,279 @@ __SIMDi _SIMD_div_epi32(__SIMDi a, __SIMDi b)
 #endif
 }
 */
-__SIMD _SIMD_madd_ps(__SIMD a, __SIMD b, __SIMD c)
+// The fused multiply-add instructions are used when they are enabled (-mfma)
+_SIMD_FUNCTION __SIMD _SIMD_madd_ps(__SIMD a, __SIMD b, __SIMD c)
 {
 #ifdef  USE_SSE
+  #ifdef __FMA__
+  return _mm_fmadd_ps(a,b,c);
+#else
   return _mm_add_ps(_mm_mul_ps(a,b),c);
+#endif
 #elif defined USE_AVX
-  return _m256_madd_ps(a,b);
+  #ifdef __FMA__
+  return _mm256_fmadd_ps(a,b,c);
+#else
+  return _mm256_add_ps(_mm256_mul_ps(a,b),c);
+#endif
 #elif defined USE_IBM
-  return vec_madd(a,b);
+  return vec_madd(a,b,c);
 #endif
 }
 
-__SIMDd _SIMD_madd_pd(__SIMDd a, __SIMDd b, __SIMDd c)
+_SIMD_FUNCTION __SIMDd _SIMD_madd_pd(__SIMDd a, __SIMDd b, __SIMDd c)
 {
 #ifdef  USE_SSE
+  #ifdef __FMA__
+  return _mm_fmadd_pd(a,b,c);
+#else
   return _mm_add_pd(_mm_mul_pd(a,b),c);
+#endif
 #elif defined USE_AVX
-  return _m256_madd_ps(a,b);
+  #ifdef __FMA__
+  return _mm256_fmadd_pd(a,b,c);
+#else
+  return _mm256_add_pd(_mm256_mul_pd(a,b),c);
+#endif
 #elif defined USE_IBM
-  return vec_madd(a,b);
+  return vec_madd(a,b,c);
 #endif
 }
 
-__SIMDi _SIMD_madd_epi32(__SIMDi a, __SIMDi b, __SIMDi c)
+_SIMD_FUNCTION __SIMDi _SIMD_madd_epi32(__SIMDi a, __SIMDi b, __SIMDi c)
 {
-#ifdef  USE_SSE
   return _SIMD_add_epi32(_SIMD_mul_epi32(a,b),c);
-#elif defined USE_AVX
-  return _m256_madd_ps(a,b);
-#elif defined USE_IBM
-  return vec_madd(a,b);
-#endif
 }
 
-__SIMD _SIMD_msub_ps(__SIMD a, __SIMD b, __SIMD c)
+_SIMD_FUNCTION __SIMD _SIMD_msub_ps(__SIMD a, __SIMD b, __SIMD c)
 {
 #ifdef  USE_SSE
+  #ifdef __FMA__
+  return _mm_fmsub_ps(a,b,c);
+#else
   return _mm_sub_ps(_mm_mul_ps(a,b),c);
+#endif
 #elif defined USE_AVX
-  return _m256_msub_ps(a,b);
+  #ifdef __FMA__
+  return _mm256_fmsub_ps(a,b,c);
+#else
+  return _mm256_sub_ps(_mm256_mul_ps(a,b),c);
+#endif
 #elif defined USE_IBM
-  return vec_msub(a,b);
+  return vec_msub(a,b,c);
 #endif
 }
 
-__SIMDd _SIMD_msub_pd(__SIMDd a, __SIMDd b, __SIMDd c)
+_SIMD_FUNCTION __SIMDd _SIMD_msub_pd(__SIMDd a, __SIMDd b, __SIMDd c)
 {
 #ifdef  USE_SSE
+  #ifdef __FMA__
+  return _mm_fmsub_pd(a,b,c);
+#else
   return _mm_sub_pd(_mm_mul_pd(a,b),c);
+#endif
 #elif defined USE_AVX
-  return _m256_msub_ps(a,b);
+  #ifdef __FMA__
+  return _mm256_fmsub_pd(a,b,c);
+#else
+  return _mm256_sub_pd(_mm256_mul_pd(a,b),c);
+#endif
 #elif defined USE_IBM
-  return vec_msub(a,b);
+  return vec_msub(a,b,c);
 #endif
 }
 
-__SIMDi _SIMD_msub_epi32(__SIMDi a, __SIMDi b, __SIMDi c)
+_SIMD_FUNCTION __SIMDi _SIMD_msub_epi32(__SIMDi a, __SIMDi b, __SIMDi c)
 {
-#ifdef  USE_SSE
   return _SIMD_sub_epi32(_SIMD_mul_epi32(a,b),c);
-#elif defined USE_AVX
-  return _m256_msub_ps(a,b);
-#elif defined USE_IBM
-  return vec_msub(a,b);
-#endif
 }
 
-__SIMD _SIMD_splats_ps(float f)
+_SIMD_FUNCTION __SIMD _SIMD_splats_ps(float f)
 {
 #ifdef  USE_SSE
   return _mm_set1_ps(f);
 #elif defined USE_AVX
-  return _m256_set1_ps(f);
+  return _mm256_set1_ps(f);
 #elif defined USE_IBM
   return vec_splats(f);
 #endif
 }
 
-__SIMDd _SIMD_splats_pd(double f)
+_SIMD_FUNCTION __SIMDd _SIMD_splats_pd(double f)
 {
 #ifdef  USE_SSE
   return _mm_set1_pd(f);
 #elif defined USE_AVX
-  return _m256_set1_pd(f);
+  return _mm256_set1_pd(f);
 #elif defined USE_IBM
   return vec_splats(f);
 #endif
 }
 
-__SIMDi _SIMD_splats_epi32(int i)
+_SIMD_FUNCTION __SIMDi _SIMD_splats_epi32(int i)
 {
 #ifdef  USE_SSE
   return _mm_set1_epi32(i);
 #elif defined USE_AVX
-  return _m256_set1_epi32(i);
+  return _mm256_set1_epi32(i);
 #elif defined USE_IBM
   return vec_splats(i);
 #endif
 }
+
+_SIMD_FUNCTION __SIMD _SIMD_loadu_ps(float* p)
+{
+#ifdef  USE_SSE
+  return _mm_loadu_ps(p);
+#elif defined USE_AVX
+  return _mm256_loadu_ps(p);
+#elif defined USE_IBM
+  return vec_xl(0,p);
+#endif
+}
+
+_SIMD_FUNCTION __SIMDd _SIMD_loadu_pd(double* p)
+{
+#ifdef  USE_SSE
+  return _mm_loadu_pd(p);
+#elif defined USE_AVX
+  return _mm256_loadu_pd(p);
+#elif defined USE_IBM
+  return vec_xl(0,p);
+#endif
+}
+
+_SIMD_FUNCTION __SIMDi _SIMD_loadu_epi32(int* p)
+{
+#ifdef  USE_SSE
+  return _mm_loadu_si128((__m128i*)p);
+#elif defined USE_AVX
+  return _mm256_loadu_si256((__m256i*)p);
+#elif defined USE_IBM
+  return vec_xl(0,p);
+#endif
+}
+
+_SIMD_FUNCTION void _SIMD_storeu_ps(float* p, __SIMD a)
+{
+#ifdef  USE_SSE
+  _mm_storeu_ps(p,a);
+#elif defined USE_AVX
+  _mm256_storeu_ps(p,a);
+#elif defined USE_IBM
+  vec_xst(a,0,p);
+#endif
+}
+
+_SIMD_FUNCTION void _SIMD_storeu_pd(double* p, __SIMDd a)
+{
+#ifdef  USE_SSE
+  _mm_storeu_pd(p,a);
+#elif defined USE_AVX
+  _mm256_storeu_pd(p,a);
+#elif defined USE_IBM
+  vec_xst(a,0,p);
+#endif
+}
+
+_SIMD_FUNCTION void _SIMD_storeu_epi32(int* p, __SIMDi a)
+{
+#ifdef  USE_SSE
+  _mm_storeu_si128((__m128i*)p,a);
+#elif defined USE_AVX
+  _mm256_storeu_si256((__m256i*)p,a);
+#elif defined USE_IBM
+  vec_xst(a,0,p);
+#endif
+}
+
+/*
+  The following functions are called once after a vectorized loop.  
+  The data elements are stored to memory and combined in the order of the loop iterations.
+*/
+_SIMD_FUNCTION float _SIMD_reduce_add_ps(__SIMD a)
+{
+  float data[sizeof(__SIMD) / sizeof(float)];
+  float result = 0;
+  int i;
+  _SIMD_storeu_ps(data,a);
+  for (i = 0; i < sizeof(__SIMD) / sizeof(float); i++)
+    result = result + data[i];
+  return result;
+}
+
+_SIMD_FUNCTION float _SIMD_reduce_mul_ps(__SIMD a)
+{
+  float data[sizeof(__SIMD) / sizeof(float)];
+  float result = 1;
+  int i;
+  _SIMD_storeu_ps(data,a);
+  for (i = 0; i < sizeof(__SIMD) / sizeof(float); i++)
+    result = result * data[i];
+  return result;
+}
+
+_SIMD_FUNCTION double _SIMD_reduce_add_pd(__SIMDd a)
+{
+  double data[sizeof(__SIMDd) / sizeof(double)];
+  double result = 0;
+  int i;
+  _SIMD_storeu_pd(data,a);
+  for (i = 0; i < sizeof(__SIMDd) / sizeof(double); i++)
+    result = result + data[i];
+  return result;
+}
+
+_SIMD_FUNCTION double _SIMD_reduce_mul_pd(__SIMDd a)
+{
+  double data[sizeof(__SIMDd) / sizeof(double)];
+  double result = 1;
+  int i;
+  _SIMD_storeu_pd(data,a);
+  for (i = 0; i < sizeof(__SIMDd) / sizeof(double); i++)
+    result = result * data[i];
+  return result;
+}
+
+_SIMD_FUNCTION int _SIMD_reduce_add_epi32(__SIMDi a)
+{
+  int data[sizeof(__SIMDi) / sizeof(int)];
+  int result = 0;
+  int i;
+  _SIMD_storeu_epi32(data,a);
+  for (i = 0; i < sizeof(__SIMDi) / sizeof(int); i++)
+    result = result + data[i];
+  return result;
+}
+
+_SIMD_FUNCTION int _SIMD_reduce_mul_epi32(__SIMDi a)
+{
+  int data[sizeof(__SIMDi) / sizeof(int)];
+  int result = 1;
+  int i;
+  _SIMD_storeu_epi32(data,a);
+  for (i = 0; i < sizeof(__SIMDi) / sizeof(int); i++)
+    result = result * data[i];
+  return result;
+}
+
+_SIMD_FUNCTION float _SIMD_last_ps(__SIMD a)
+{
+  float data[sizeof(__SIMD) / sizeof(float)];
+  _SIMD_storeu_ps(data,a);
+  return data[sizeof(__SIMD) / sizeof(float) - 1];
+}
+
+_SIMD_FUNCTION double _SIMD_last_pd(__SIMDd a)
+{
+  double data[sizeof(__SIMDd) / sizeof(double)];
+  _SIMD_storeu_pd(data,a);
+  return data[sizeof(__SIMDd) / sizeof(double) - 1];
+}
+
+_SIMD_FUNCTION int _SIMD_last_epi32(__SIMDi a)
+{
+  int data[sizeof(__SIMDi) / sizeof(int)];
+  _SIMD_storeu_epi32(data,a);
+  return data[sizeof(__SIMDi) / sizeof(int) - 1];
+}
@@ -6,6 +6,8 @@
 #include <vector>
 #include <iostream>
 #include <fstream>
+#include <map>
+#include <set>
 
 namespace SIMDVectorization 
 {
@@ -13,8 +15,12 @@ namespace SIMDVectorization
   void addHeaderFile(SgProject*);
 //  Perform strip-mining on a loop.  The integer argument is the vector factor.
   void stripmineLoop(SgForStatement*, int);
-//  Perform strip-mining transformation on a vectorizable loop, update its loop stride.
-  void updateLoopIteration(SgForStatement*, int);
+//  Perform strip-mining transformation on a vectorizable loop, update its loop stride.  Return the symbol of the strip index.
+  SgVariableSymbol* updateLoopIteration(SgForStatement*, int);
+//  Vectorize the innermost loop, with the prologue and remainder loops.  The integer argument is the vector factor.
+//  The remaining arguments are the results of SIMDAnalysis::getVectorizableType.
+  void vectorizeLoop(SgForStatement*, int, SgType*, const std::map<SgInitializedName*, VariantT>&, 
+                     const std::set<SgInitializedName*>&);
 //  vectorize the innermost loop by translating binary operations into SIMD intrinsic function calls
   void vectorizeBinaryOp(SgForStatement*);
 //  translate the binary operator to SIMD intrisic functions
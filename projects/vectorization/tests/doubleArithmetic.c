@@ -0,0 +1,20 @@
+/*
+  Test vectorization for double precision operands.
+  The vector factor is 2 for SSE and 4 for AVX.
+*/
+#include "testSupport.h"
+
+int main(){
+  double x[64];
+  double y[64];
+  double alpha = 2.0;
+  int n = 64;
+  initDoubles(x, n);
+  initDoubles(y, n);
+  for (int i=0;i<n;i++)
+  {
+    y[i] += alpha * x[i];
+  }
+  printDoubles("y", y, n);
+  return 0;
+}
@@ -0,0 +1,23 @@
+/*
+  Test vectorization for non-unit-stride references.
+  a[idx[i]] and a[2*i] are gathered into temporary arrays by scalar loops.
+  c[j] is loop invariant, and stored in all data elements of a SIMD operand.
+*/
+#include "testSupport.h"
+
+int main(){
+  float a[512];
+  float b[256];
+  float c[16];
+  int idx[256];
+  int j = 3;
+  initFloats(a, 512);
+  initFloats(c, 16);
+  initIndices(idx, 256, 512);
+  for (int i=0;i<256;i++)
+  {
+    b[i] = a[idx[i]] * a[2*i] + c[j];
+  }
+  printFloats("b", b, 256);
+  return 0;
+}
@@ -0,0 +1,28 @@
+/*
+  Test vectorization for reductions.
+  The partial sums are accumulated in SIMD variables, and combined after the loop.
+*/
+#include <stdio.h>
+#include "testSupport.h"
+
+float a[1000];
+float b[1000];
+float c[1000];
+
+int main(){
+  int n = 1000;
+  float sum = 0;
+  float dot = 0;
+  float product = 1;
+  initFloats(a, n);
+  initFloats(b, n);
+  initFactors(c, n);
+  for (int i=0;i<n;i++)
+  {
+    sum += a[i];
+    dot += a[i] * b[i];
+    product *= c[i];
+  }
+  printf("sum: %g dot: %g product: %g\n", sum, dot, product);
+  return 0;
+}
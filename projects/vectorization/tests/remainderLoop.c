@@ -0,0 +1,24 @@
+/*
+  Test vectorization for a loop whose iteration count is not a multiple of the vector factor.
+  The last iterations are executed by the remainder loop.
+  The loop with a dependence carried by a[i+1] = a[i] is not vectorized.
+*/
+#include "testSupport.h"
+
+int main(){
+  float a[103];
+  float b[103];
+  int n = 103;
+  initFloats(b, n);
+  for (int i=0;i<n;i++)
+  {
+    a[i] = -b[i];
+  }
+  printFloats("a", a, n);
+  for (int i=0;i<n-1;i++)
+  {
+    a[i+1] = a[i] + b[i];
+  }
+  printFloats("a", a, n);
+  return 0;
+}
@@ -0,0 +1,57 @@
+/*
+  Input and output of the tests which are run by "make check".
+  The tests are compiled from the original source and from the source translated by the vectorization,
+  and the outputs of both have to agree.
+
+  This file is not translated.  The input values are small integers, or powers of two for products,
+  so that the reductions computed in a different order by the SIMD code still give the same results.
+*/
+#include <stdio.h>
+
+// -0 and 0 are printed the same, since a negation can give either of them
+static double printedValue(double x)
+{
+  return x == 0 ? 0 : x;
+}
+
+void initFloats(float* a, int n)
+{
+  for (int i=0;i<n;i++)
+    a[i] = (float)((i * 7) % 13 - 5);
+}
+
+void initDoubles(double* a, int n)
+{
+  for (int i=0;i<n;i++)
+    a[i] = (double)((i * 5) % 11 - 5);
+}
+
+// 2 for every 10th element, 0.5 for every 20th element from the 5th
+void initFactors(float* a, int n)
+{
+  for (int i=0;i<n;i++)
+    a[i] = (i % 10 == 0) ? 2.0f : ((i % 20 == 5) ? 0.5f : 1.0f);
+}
+
+// Indices in [0, range)
+void initIndices(int* a, int n, int range)
+{
+  for (int i=0;i<n;i++)
+    a[i] = (i * 37) % range;
+}
+
+void printFloats(const char* name, const float* a, int n)
+{
+  printf("%s:", name);
+  for (int i=0;i<n;i++)
+    printf(" %g", printedValue(a[i]));
+  printf("\n");
+}
+
+void printDoubles(const char* name, const double* a, int n)
+{
+  printf("%s:", name);
+  for (int i=0;i<n;i++)
+    printf(" %g", printedValue(a[i]));
+  printf("\n");
+}
@@ -0,0 +1,14 @@
+/*
+  Input and output of the tests which are run by "make check", see testSupport.c
+*/
+#ifndef TEST_SUPPORT_H
+#define TEST_SUPPORT_H
+
+void initFloats(float* a, int n);
+void initDoubles(double* a, int n);
+void initFactors(float* a, int n);
+void initIndices(int* a, int n, int range);
+void printFloats(const char* name, const float* a, int n);
+void printDoubles(const char* name, const double* a, int n);
+
+#endif
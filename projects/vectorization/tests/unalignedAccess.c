@@ -0,0 +1,30 @@
+/*
+  Test vectorization for unit-stride references which are not aligned.
+  a[i-1] and a[i+1] are loaded by _SIMD_loadu_ps, p[i] is stored by _SIMD_storeu_ps.
+  The prologue loop aligns a[i] and b[i], since the loop starts from 1.
+*/
+#include "testSupport.h"
+
+void stencil(float* p, int n){
+  float a[256];
+  float b[256];
+  float t;
+  initFloats(a, 256);
+  initFloats(b, 256);
+  for (int i=1;i<n-1;i++)
+  {
+    t = a[i-1] + a[i+1];
+    b[i] = 0.5f * t + a[i];
+    p[i] = b[i] * 2.0f;
+  }
+  printFloats("b", b, 256);
+}
+
+int main(){
+  float p[257];
+  initFloats(p, 257);
+  // p+1 is not aligned to the SIMD vectors
+  stencil(p + 1, 256);
+  printFloats("p", p, 257);
+  return 0;
+}
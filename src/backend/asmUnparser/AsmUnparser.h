@@ -595,7 +595,10 @@ public:
         Disassembler *disassembler;
         AsmUnparser *unparser;
         bool unparser_allocated_here;
-        StaticDataDisassembler(): disassembler(NULL), unparser(NULL), unparser_allocated_here(false) {}
+        RTS_mutex_t mutex;                      /**< Serializes use of "unparser" by the threads of a parallel unparse. */
+        StaticDataDisassembler(): disassembler(NULL), unparser(NULL), unparser_allocated_here(false) {
+            RTS_mutex_init(&mutex, RTS_LAYER_ROSE_ASM_UNPARSER_OBJ, NULL);
+        }
         ~StaticDataDisassembler() { reset(); }
         virtual void reset();
         virtual void init(Disassembler *disassembler, AsmUnparser *unparser=NULL);
@@ -783,7 +786,7 @@ public:
      **************************************************************************************************************************/
 
     /** Constructor that intializes the "unparser" callback lists with some useful functors. */
-    AsmUnparser(): user_registers(NULL), interp_registers(NULL) {
+    AsmUnparser(): user_registers(NULL), interp_registers(NULL), nthreads(1), active_workers(0) {
         init();
     }
 
@@ -917,12 +920,41 @@ public:
      * @{ */
     virtual void set_prefix_format(const std::string &format) { lineprefix.format = format; }
     virtual const std::string& get_prefix_format() const { return lineprefix.format; }
-    virtual void set_prefix_address(rose_addr_t va) { lineprefix.address = va; }
-    virtual rose_addr_t get_prefix_address() const { return lineprefix.address; }
+    virtual void set_prefix_address(rose_addr_t va);
+    virtual rose_addr_t get_prefix_address() const;
     virtual std::string line_prefix() const;
     virtual std::string blank_prefix() const { return std::string(line_prefix().size(), ' '); }
     /** @} */
 
+    /** Controls parallel formatting.
+     *
+     *  When the number of threads is greater than one and the output is organized by AST, the top-level nodes found by
+     *  unparse() and the functions of an interpretation are formatted by worker threads, each node into its own buffer, and
+     *  the buffers are written to the output stream in their original order (i.e., functions appear in address order) as soon
+     *  as they're complete.  Only a few nodes per thread are buffered at any time, so the memory used by the output does not
+     *  grow with the size of the listing.  The output is identical to that of a single thread.
+     *
+     *  The callbacks are invoked concurrently for different nodes, so they must not modify shared state, including state
+     *  modified indirectly (e.g., instruction semantics policies that number their values with a global counter).  The line
+     *  prefix address is private to each thread.  The built-in callbacks other than basicBlockNoopUpdater only read the AST,
+     *  but no callback is assumed to be safe merely because it is installed: see is_parallel_safe(), which causes formatting
+     *  to happen in the calling thread when it returns false.  The number of threads is ignored if ROSE was configured without
+     *  multi-thread support.
+     *  @{ */
+    virtual void set_nthreads(size_t n) { nthreads = n; }
+    virtual size_t get_nthreads() const { return nthreads; }
+    /** @} */
+
+    /** Determines whether nodes can be formatted in parallel.  Returns false if output is organized by address (skip/back
+     *  reporting and block separation carry state from one node to the next) or if the basicBlockNoopUpdater is installed
+     *  (its results are stored in the unparser's insn_is_noop vector).  Subclasses that install callbacks which store state in
+     *  the unparser or elsewhere, or which call code that does, must augment this. */
+    virtual bool is_parallel_safe() const;
+
+    /** Unparse a list of nodes in order.  This is called by unparse() and by the InterpBody callback, and formats the nodes on
+     *  multiple threads when possible (see set_nthreads()).  Returns the number of nodes. */
+    virtual size_t unparse_nodes(std::ostream&, const std::vector<SgNode*>&);
+
 protected:
     struct CallbackLists {
         ROSE_Callbacks::List<UnparserCallback> unparse;                 /**< The main unparsing callbacks. */
@@ -1003,6 +1035,13 @@ protected:
         std::string format;             /**< Printf-style format string. This may contain a format for a uint64_t address. */
         rose_addr_t address;            /**< Address to use when generating a prefix string. */
     } lineprefix;
+
+    /** Number of threads for formatting. See set_nthreads(). */
+    size_t nthreads;
+
+    /** Number of worker threads currently formatting for this unparser.  While non-zero, the prefix address is stored per
+     *  thread rather than in lineprefix. */
+    size_t active_workers;
 };
 
 #endif
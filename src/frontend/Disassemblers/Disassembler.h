@@ -216,6 +216,21 @@ public:
      *  address. */
     typedef std::map<rose_addr_t, Exception> BadMap;
 
+    /** Summary of one instruction as returned by decodeOne().  It carries the instruction's size and control flow information
+     *  without any IR nodes, so filling one in does not allocate memory.  The control flow members have the same meaning as
+     *  SgAsmInstruction::terminates_basic_block() and SgAsmInstruction::get_successors() on the corresponding instruction.
+     *  An instruction has at most two statically known successors: the branch target and the fall-through address. */
+    struct InstructionInfo {
+        rose_addr_t va;                 /**< Starting address of the instruction. */
+        size_t size;                    /**< Size of the instruction in bytes. */
+        int kind;                       /**< Architecture-specific kind (e.g., X86InstructionKind) or -1 if not determined.
+                                         *   The kind is always determined for instructions that terminate a basic block. */
+        bool terminates_block;          /**< True if the instruction naively terminates a basic block. */
+        bool complete;                  /**< True if the successors are the complete set of successors. */
+        size_t nsuccessors;             /**< Number of valid entries in the @p successors array. */
+        rose_addr_t successors[2];      /**< Statically known successor addresses in no particular order. */
+    };
+
     Disassembler()
         : p_registers(NULL), p_partitioner(NULL), p_search(SEARCH_DEFAULT), p_debug(NULL),
           p_wordsize(4), p_sex(SgAsmExecutableFileFormat::ORDER_LSB), p_alignment(4), p_ndisassembled(0),
@@ -483,6 +498,17 @@ public:
     SgAsmInstruction *disassembleOne(const unsigned char *buf, rose_addr_t buf_va, size_t buf_size, rose_addr_t start_va,
                                      AddressSet *successors=NULL);
 
+    /** Decodes one instruction without building it.  This is for analyses that scan large amounts of code but need only the
+     *  length and control flow of most instructions (e.g., looking for instruction boundaries or branch targets); they can call
+     *  disassembleOne() later for those few instructions whose full IR they need.  On success, the @p info is filled in and
+     *  true is returned.  If the bytes at @p start_va are not a valid instruction then false is returned and @p info is
+     *  undefined; call disassembleOne() to obtain the reason.  The default implementation calls disassembleOne() and then
+     *  deletes the instruction; subclasses override it to decode common instructions without constructing any IR nodes.
+     *
+     *  Thread safety:  The safety of this method depends on its implementation in the subclass. In any case, no other thread
+     *  can be modifying the MemoryMap at the same time. */
+    virtual bool decodeOne(const MemoryMap *map, rose_addr_t start_va, InstructionInfo *info);
+
 
 
 
@@ -655,6 +681,12 @@ public:
      *  Thread safety: Thread safe provided no other thread is modifying the specified instruction map. */
     AddressSet get_block_successors(const InstructionMap&, bool *complete);
 
+    /** Fills in an InstructionInfo from an instruction.  The kind is set to -1 since it is architecture-specific; subclasses
+     *  may set it afterward.
+     *
+     *  Thread safety: Thread safe provided no other thread is modifying the instruction. */
+    static void summarize_instruction(SgAsmInstruction*, InstructionInfo*);
+
 private:
     /** Initialize class (e.g., register built-in disassemblers). This class method is thread safe, using class_mutex. */
     static void initclass();
@@ -46,6 +46,15 @@ public:
     virtual SgAsmInstruction *disassembleOne(const MemoryMap *map, rose_addr_t start_va,
                                              AddressSet *successors=NULL) /*override*/;
 
+    /** See Disassembler::decodeOne.  The general-purpose, x87, and control transfer instructions that make up most code are
+     *  decoded directly from the bytes without constructing any IR nodes; the remaining instructions (SSE, system
+     *  instructions, etc.) are fully disassembled and then discarded.  The kind is determined for all instructions that
+     *  terminate a basic block but only for some of the others.
+     *
+     *  Thread safety: Multiple threads can call this method on the same object provided that none of them needs to fall back
+     *  to the full disassembler, which is not thread safe. */
+    virtual bool decodeOne(const MemoryMap *map, rose_addr_t start_va, InstructionInfo *info) /*override*/;
+
     /** Make an unknown instruction from an exception. */
     virtual SgAsmInstruction *make_unknown_instruction(const Exception&) /*override*/;
 
@@ -108,6 +117,17 @@ private:
      *  than 15 bytes. The longest possible x86 instruction is 15 bytes. */
     uint64_t getQWord();
 
+    /*========================================================================================================================
+     * Allocation-free decoding
+     *========================================================================================================================*/
+private:
+
+    /** Decodes the instruction at the beginning of @p buf (@p bufsz bytes mapped at @p start_va) without constructing any IR
+     *  nodes.  Returns false for all instructions it does not handle, including invalid ones, in which case decodeOne() falls
+     *  back to disassemble().  For instructions it accepts, the result must agree with disassemble() in every detail
+     *  stored in the InstructionInfo. */
+    bool decodeFast(const uint8_t *buf, size_t bufsz, rose_addr_t start_va, InstructionInfo *info) const;
+
     /*========================================================================================================================
      * Miscellaneous helper methods
      *========================================================================================================================*/
@@ -9,6 +9,18 @@
 #define NAN (INFINITY-INFINITY)
 #endif
 
+/* Forward declarations for the semantic policy cached in each basic block; see Partitioner::block_semantics(). The definitions
+ * are in PartialSymbolicSemantics.h, which is not included here because this header is included by rose.h. */
+namespace BinaryAnalysis {
+    namespace InstructionSemantics {
+        namespace PartialSymbolicSemantics {
+            template<size_t nBits> struct ValueType;
+            template<template<size_t> class ValueType> struct State;
+            template<template<template<size_t> class> class State, template<size_t> class ValueType> class Policy;
+        }
+    }
+}
+
 /** Partitions instructions into basic blocks and functions.
  *
  *  The Partitioner classes are responsible for assigning instructions to basic blocks, and basic blocks to functions.  A
@@ -206,6 +218,14 @@ protected:
                                                  *   block. */
     };
 
+    /** Semantic policy used to summarize basic blocks.  See block_semantics(). */
+    typedef BinaryAnalysis::InstructionSemantics::PartialSymbolicSemantics::Policy<
+        BinaryAnalysis::InstructionSemantics::PartialSymbolicSemantics::State,
+        BinaryAnalysis::InstructionSemantics::PartialSymbolicSemantics::ValueType> SemanticPolicy;
+
+    /** Semantics of the first few instructions of a basic block.  Defined in Partitioner.C; see block_semantics(). */
+    struct BlockSemantics;
+
     /** Represents a basic block within the Partitioner. Each basic block will eventually become an SgAsmBlock node in the
      *  AST. However, if the SgAsmFunction::FUNC_LEFTOVER bit is set in the Partitioner::set_search() method then
      *  blocks that were not assigned to any function to not result in an SgAsmBlock node.
@@ -242,6 +262,7 @@ protected:
         BlockAnalysisCache cache;               /**< Cached results of local analyses */
         Function* function;                     /**< Function to which this basic block is assigned, or null */
         double code_likelihood;                 /**< Likelihood (0..1) that this is code. One unless detected statistically. */
+        boost::shared_ptr<BlockSemantics> semantics; /**< Cached semantics of a prefix of insns; see block_semantics() */
     };
     typedef std::map<rose_addr_t, BasicBlock*> BasicBlocks;
 
@@ -1447,6 +1468,8 @@ public:
     virtual SgAsmBlock* build_ast(DataBlock*);                  /**< Build an AST for a single data block. */
     virtual bool pops_return_address(rose_addr_t);              /**< Determines if a block pops the stack w/o returning */
     virtual void update_analyses(BasicBlock*);                  /* Makes sure cached analysis results are current. */
+    virtual const SemanticPolicy *block_semantics(BasicBlock*); /* Semantics of a whole block, computed incrementally. */
+    virtual bool function_semantics(Function*, SemanticPolicy*); /* Composed semantics of a single-path function. */
     virtual rose_addr_t canonic_block(rose_addr_t);             /**< Follow alias links in basic blocks. */
     virtual bool is_function_call(BasicBlock*, rose_addr_t*);   /* True if basic block appears to call a function. */
     virtual bool is_thunk(Function*);                           /* True if function is a thunk. */
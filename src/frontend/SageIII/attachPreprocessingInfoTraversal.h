@@ -163,6 +163,49 @@ class AttachPreprocessingInfoTreeTrav
           ROSEAttributesList* buildCommentAndCppDirectiveList ( bool use_Wave, std::string currentFilename );
    };
 
+// Process-wide cache of the comments and CPP directives collected by the lex pass from header 
+// files (used with -rose:collectAllCommentsAndDirectives), so that a header included by many 
+// source files of a project is lexed only once.  Entries are keyed by the path of the header and 
+// are only used while its size and modification time are unchanged.  Since the attachment of 
+// comments and directives to the AST consumes the list it is given, lookup() returns a new list 
+// of copies.  If a cache directory is specified (-rose:commentsAndDirectivesCacheDirectory DIR) 
+// the lists are also written to (and read from) that directory so that they are reused by 
+// later runs.
+class PreprocessingInfoCache
+   {
+     public:
+       // Returns a new list for the file or NULL if it is not cached (or has changed since)
+          static ROSEAttributesList* lookup ( const std::string & fileName, const std::string & cacheDirectory );
+
+       // Records a copy of the list collected from the file
+          static void insert ( const std::string & fileName, ROSEAttributesList* listOfAttributes, const std::string & cacheDirectory );
+
+       // Reports the number of lookups and the hit rate
+          static void report ( std::ostream & os );
+
+     private:
+          class Entry
+             {
+               public:
+                    long long size;
+                    long long modificationTime;
+                    std::vector<PreprocessingInfo*> attributeList;
+                    LexTokenStreamTypePointer rawTokenStream;
+
+                    Entry() : size(-1), modificationTime(-1), rawTokenStream(NULL) {}
+             };
+
+          static bool fileSizeAndModificationTime ( const std::string & fileName, long long & size, long long & modificationTime );
+          static std::string diskCacheFileName ( const std::string & fileName, const std::string & cacheDirectory );
+          static bool readEntry ( const std::string & fileName, const std::string & cacheDirectory, Entry & entry );
+          static void writeEntry ( const std::string & fileName, const std::string & cacheDirectory, const Entry & entry );
+
+          static std::map<std::string,Entry> entries;
+          static size_t numberOfHits;
+          static size_t numberOfDiskHits;
+          static size_t numberOfMisses;
+   };
+
 #endif
 
 // EOF
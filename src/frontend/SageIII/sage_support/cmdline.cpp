@@ -254,6 +254,7 @@ CommandlineProcessing::isOptionTakingSecondParameter( string argument )
           argument == "-rose:includeCommentsAndDirectivesFrom" ||
           argument == "-rose:excludeCommentsAndDirectives" ||
           argument == "-rose:excludeCommentsAndDirectivesFrom" ||
+          argument == "-rose:commentsAndDirectivesCacheDirectory" ||
           argument == "-rose:includePath" ||
           argument == "-rose:excludePath" ||
           argument == "-rose:includeFile" ||
@@ -295,6 +296,7 @@ CommandlineProcessing::isOptionTakingSecondParameter( string argument )
 
        // DQ (9/26/2011): Added support for detection of dangling pointers within translators built using ROSE.
           argument == "-rose:detect_dangling_pointers" ||   // Used to specify level of debugging support for optional detection of dangling pointers 
+          argument == "-rose:ast_consistency_level" ||      // Used to specify how thorough the AST consistency tests are
           false)
         {
           result = true;
@@ -1239,6 +1241,10 @@ SgFile::usage ( int status )
 "                             provide filename to file with paths to include\n"
 "                             when using the collectAllCommentsAndDirectives\n"
 "                             option\n"
+"     -rose:commentsAndDirectivesCacheDirectory DIRECTORY\n"
+"                             save the comments and CPP directives collected\n"
+"                             from header files (collectAllCommentsAndDirectives)\n"
+"                             in DIRECTORY so that later runs don't reread them\n"
 "     -rose:skip_commentsAndDirectives\n"
 "                             ignore all comments and CPP directives (can\n"
 "                             generate (unparse) invalid code if not used with\n"
@@ -1403,6 +1409,13 @@ SgFile::usage ( int status )
 "                               0: off (does not issue warning)\n"
 "                               1: on (issues warning with information)\n"
 "                               2: on (issues error and exists)\n"
+"     -rose:ast_consistency_level LEVEL\n"
+"                             selects the AST consistency tests run by translators\n"
+"                             LEVEL is one of:\n"
+"                               1: fast (structural tests of the AST only)\n"
+"                               2: standard (default)\n"
+"                               3: exhaustive (adds l-value, memory pool pointer and\n"
+"                                  disconnected AST tests)\n"
 "\n"
 "Testing Options:\n"
 "     -rose:negative_test     test ROSE using input that is expected to fail\n"
@@ -2323,6 +2336,13 @@ SgFile::processRoseCommandLineOptions ( vector<string> & argv )
           set_collectAllCommentsAndDirectives(true);
         }
 
+  // The comments and CPP directives of header files are cached for the whole process; this directory 
+  // (it should be the same for the whole project) also keeps them across runs.
+     if (CommandlineProcessing::isOptionWithParameter(argv, "-rose:", "(commentsAndDirectivesCacheDirectory)", stringParameter, true) == true)
+        {
+          get_project()->set_commentsAndDirectivesCacheDirectory(stringParameter);
+        }
+
      // negara1 (07/08/2011): Made unparsing of header files optional. 
      if ( CommandlineProcessing::isOption(argv,"-rose:","(unparseHeaderFiles)",true) == true )
         {
@@ -2467,6 +2487,22 @@ SgFile::processRoseCommandLineOptions ( vector<string> & argv )
           set_detect_dangling_pointers(integerDebugOption);
         }
 
+  // Level of AST consistency testing done by AstTests::runAllTests().
+     int integerConsistencyLevel = 0;
+     if ( CommandlineProcessing::isOptionWithParameter(argv,"-rose:","ast_consistency_level",integerConsistencyLevel,true) == true )
+        {
+          if (integerConsistencyLevel < 1 || integerConsistencyLevel > 3)
+             {
+               printf ("Error: option -rose:ast_consistency_level requires a level of 1 (fast), 2 (standard) or 3 (exhaustive) \n");
+               ROSE_ASSERT(false);
+             }
+
+          if ( SgProject::get_verbose() >= 1 )
+               printf ("option -rose:ast_consistency_level found with level = %d \n",integerConsistencyLevel);
+
+          set_ast_consistency_level(integerConsistencyLevel);
+        }
+
   //
   // internal testing option (for internal use only, these may disappear at some point)
   //
@@ -2751,6 +2787,8 @@ SgFile::stripRoseCommandLineOptions ( vector<string> & argv )
      optionCount = sla(argv, "-rose:", "($)^", "(excludeCommentsAndDirectivesFrom)", &integerOption, 1);
      optionCount = sla(argv, "-rose:", "($)^", "(includeCommentsAndDirectives)", &integerOption, 1);
      optionCount = sla(argv, "-rose:", "($)^", "(includeCommentsAndDirectivesFrom)", &integerOption, 1);
+     char* commentsAndDirectivesCacheDirectoryOption = NULL;
+     optionCount = sla(argv, "-rose:", "($)^", "(commentsAndDirectivesCacheDirectory)", commentsAndDirectivesCacheDirectoryOption, 1);
 
   // DQ (12/8/2007): Strip use of the "-rose:output <filename> option.
      optionCount = sla(argv, "-rose:", "($)^", "(o|output)", filename, 1);
@@ -2784,6 +2822,7 @@ SgFile::stripRoseCommandLineOptions ( vector<string> & argv )
 
   // DQ (9/26/2011): Added support for different levesl of detection for dangling pointers.
      optionCount = sla(argv, "-rose:", "($)^", "detect_dangling_pointers",&integerOption,1);
+     optionCount = sla(argv, "-rose:", "($)^", "ast_consistency_level",&integerOption,1);
 
 #if 1
      if ( (ROSE_DEBUG >= 1) || (SgProject::get_verbose() > 2 ))
@@ -61,6 +61,20 @@ class ROSE_DLL_API AstTests
           static unsigned int numSingleSuccs(SgNode* node);
           static bool isProblematic(SgNode* node);
 
+       //! Levels of AST consistency testing, selected with -rose:ast_consistency_level LEVEL.
+       /*! The fast level runs only the structural tests (AST properties, cycles and the checks of
+           declarations, scopes and symbol tables).  The standard level adds the mangled name, expression
+           type, l-value, memory pool and type tests.  The exhaustive level adds tests that are too slow
+           or too strict to be run by default (corrected l-values, pointers into the memory pools and
+           disconnected parts of the AST). */
+          enum consistency_level_enum
+             {
+               e_unspecified_level = 0,
+               e_fast_level        = 1,
+               e_standard_level    = 2,
+               e_exhaustive_level  = 3
+             };
+
        //! Test codes that traverse the AST
           static void runAllTests(SgProject* sageProject);
           static bool isCorrectAst(SgProject* sageProject);
@@ -252,6 +266,9 @@ class TestMangledNames : public ROSE_VisitTraversal
 
       //! visit function required for traversal
           void visit ( SgNode* node );
+
+      //! Output the mangled name statistics gathered by the traversal (only when verbose)
+          void outputStatistics() const;
    };
 
 #if 0
@@ -428,6 +445,29 @@ class MemoryCheckingTraversalForAstFileIO : public ROSE_VisitTraversal
           void visit ( SgNode* node );
    };
 
+/*! \brief Runs several memory pool tests in a single traversal of the memory pools.
+
+    Each IR node in the memory pools is visited once and handed to every test in the order
+    the tests were added, so that the memory pools are walked once instead of once per test.
+    This is the memory pool counterpart of AstCombinedSimpleProcessing.
+ */
+class CombinedMemoryPoolTests : public ROSE_VisitTraversal
+   {
+     public:
+          typedef std::vector<ROSE_VisitTraversal*> TraversalPtrList;
+
+          virtual ~CombinedMemoryPoolTests() {};
+
+       // The tests are not owned by this object.
+          void addTraversal(ROSE_VisitTraversal* t);
+          TraversalPtrList & get_traversalPtrListRef();
+
+          void visit( SgNode* node );
+
+     private:
+          TraversalPtrList traversals;
+   };
+
 
 
 
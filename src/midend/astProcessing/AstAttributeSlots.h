@@ -0,0 +1,292 @@
+#ifndef ASTATTRIBUTESLOTS_H
+#define ASTATTRIBUTESLOTS_H
+
+// Typed attribute slots: a faster alternative to AstAttributeMechanism for analyses that annotate
+// many IR nodes. A slot is registered once and identified by a small integer key that carries the C++
+// type of its values; the values are stored in a per-key table indexed by the memory pool id of the
+// node, so setting or reading a value does not compare strings or allocate per node.  The table is
+// split into pages of consecutive ids that are only allocated when a value in them is set, so a key
+// that annotates a few nodes does not pay for every node in the memory pools.
+//
+// Example:
+//      static AstAttributeKey<int> depthKey = AstAttributeSlots::registerKey<int>("depth");
+//      AstAttributeSlots::set(node,depthKey,3);
+//      int depth = AstAttributeSlots::get(node,depthKey);
+//
+// The string keyed attributes (SgNode::addNewAttribute(), etc.) are not affected.
+
+#include <string>
+#include <vector>
+#include <typeinfo>
+#include <cassert>
+#include "rosedll.h"
+
+class SgNode;
+
+/*! \brief Dense ids for IR nodes derived from their position in the memory pools.
+
+   Every block of a memory pool is registered (by the generated new operator and by the AST File I/O)
+   with a range of ids, so a node's id is computed from its address and never changes while the node
+   is alive.  Ids of deleted nodes are reused by the nodes later allocated in the same slot.
+
+\internal Lookups are not synchronized with the allocation of new memory pool blocks by other threads.
+*/
+class ROSE_DLL_API AstMemoryPoolNodeId
+   {
+     public:
+       // Returned for nodes not allocated from a memory pool (e.g. objects of user classes derived from IR nodes).
+          static const size_t invalidNodeId = ~(size_t)0;
+
+          static void registerBlock ( const void* block, size_t numberOfElements, size_t elementSize );
+
+          static size_t nodeId ( const SgNode* node );
+
+       // Upper bound of all ids handed out so far
+          static size_t numberOfNodeIds ();
+   };
+
+
+/*! \brief Base class of the per-key value tables (the type is only known to the derived template).
+*/
+class ROSE_DLL_API AstAttributeSlotTable
+   {
+     public:
+          AstAttributeSlotTable ( const std::string & name, const std::type_info & type );
+          virtual ~AstAttributeSlotTable ();
+
+          const std::string & get_name () const { return name; }
+          const std::type_info & get_type () const { return type; }
+
+          virtual bool exists ( size_t nodeId ) const = 0;
+
+       // Resets the value of a single node (or of all nodes) to the default value of the key.
+          virtual void erase ( size_t nodeId ) = 0;
+          virtual void clear () = 0;
+
+       // Bytes used by the table (not counting memory owned by the values themselves).
+          virtual size_t memoryUsage () const = 0;
+
+     protected:
+          std::string name;
+          const std::type_info & type;
+
+     private:
+       // Tables are owned by AstAttributeSlots and never copied.
+          AstAttributeSlotTable ( const AstAttributeSlotTable & );
+          AstAttributeSlotTable & operator= ( const AstAttributeSlotTable & );
+   };
+
+template <class T>
+class AstAttributeSlotValues : public AstAttributeSlotTable
+   {
+     public:
+       // Number of consecutive node ids per page (a page is allocated when the first of its values is set).
+          static const size_t nodesPerPage = 1024;
+
+          AstAttributeSlotValues ( const std::string & name, const T & defaultValue )
+             : AstAttributeSlotTable(name,typeid(T)), defaultValue(defaultValue)
+             {
+             }
+
+          ~AstAttributeSlotValues ()
+             {
+               clear();
+             }
+
+          bool exists ( size_t nodeId ) const
+             {
+               const Page* page = findPage(nodeId);
+               return page != NULL && page->present[nodeId % nodesPerPage];
+             }
+
+          const T & get ( size_t nodeId ) const
+             {
+               const Page* page = findPage(nodeId);
+               return page != NULL ? page->values[nodeId % nodesPerPage] : defaultValue;
+             }
+
+       // Returns a reference to the value of the node (which is created with the default value if needed).
+          T & reference ( size_t nodeId )
+             {
+               size_t pageIndex = nodeId / nodesPerPage;
+               if (pageIndex >= pages.size())
+                    pages.resize(pageIndex + 1,NULL);
+               if (pages[pageIndex] == NULL)
+                    pages[pageIndex] = new Page(defaultValue);
+
+               Page* page = pages[pageIndex];
+               size_t offset = nodeId % nodesPerPage;
+               if (page->present[offset] == false)
+                  {
+                    page->present[offset] = true;
+                    page->numberOfValues++;
+                  }
+               return page->values[offset];
+             }
+
+          void erase ( size_t nodeId )
+             {
+               size_t pageIndex = nodeId / nodesPerPage;
+               Page* page = pageIndex < pages.size() ? pages[pageIndex] : NULL;
+               size_t offset = nodeId % nodesPerPage;
+               if (page != NULL && page->present[offset] == true)
+                  {
+                    page->values[offset] = defaultValue;
+                    page->present[offset] = false;
+                    if (--page->numberOfValues == 0)
+                       {
+                         delete page;
+                         pages[pageIndex] = NULL;
+                       }
+                  }
+             }
+
+          void clear ()
+             {
+               for (size_t i = 0; i < pages.size(); i++)
+                    delete pages[i];
+               std::vector<Page*>().swap(pages);
+             }
+
+          size_t memoryUsage () const
+             {
+               size_t numberOfPages = 0;
+               for (size_t i = 0; i < pages.size(); i++)
+                    numberOfPages += (pages[i] != NULL);
+               return pages.capacity() * sizeof(Page*) + numberOfPages * (sizeof(Page) + nodesPerPage * sizeof(T) + nodesPerPage / 8);
+             }
+
+     private:
+          struct Page
+             {
+               Page ( const T & defaultValue ) : values(nodesPerPage,defaultValue), present(nodesPerPage,false), numberOfValues(0) {}
+
+               std::vector<T> values;
+               std::vector<bool> present;
+               size_t numberOfValues;
+             };
+
+          const Page* findPage ( size_t nodeId ) const
+             {
+               size_t pageIndex = nodeId / nodesPerPage;
+               return pageIndex < pages.size() ? pages[pageIndex] : NULL;
+             }
+
+          T defaultValue;
+          std::vector<Page*> pages;
+   };
+
+template <class T>
+const size_t AstAttributeSlotValues<T>::nodesPerPage;
+
+
+/*! \brief Integer key of an attribute slot holding values of type T (see AstAttributeSlots).
+*/
+template <class T>
+class AstAttributeKey
+   {
+     public:
+          AstAttributeKey () : index(invalidIndex) {}
+          explicit AstAttributeKey ( unsigned int index ) : index(index) {}
+
+          bool isValid () const { return index != invalidIndex; }
+          unsigned int get_index () const { return index; }
+
+     private:
+          static const unsigned int invalidIndex = ~0u;
+          unsigned int index;
+   };
+
+
+/*! \brief Registry of the typed attribute slots.
+
+   Keys are registered by name; registering an existing name with the same type returns the existing
+   key (so that independent translation units can share a slot), registering it with another type is
+   an error.  Values of a node are reset when the node is deleted.
+
+\internal Keys should be registered before any threads access the slots.
+*/
+class ROSE_DLL_API AstAttributeSlots
+   {
+     public:
+          template <class T>
+          static AstAttributeKey<T> registerKey ( const std::string & name, const T & defaultValue = T() )
+             {
+               unsigned int index = findKey(name);
+               if (index == (unsigned int)tables().size())
+                  {
+                    tables().push_back(new AstAttributeSlotValues<T>(name,defaultValue));
+                  }
+               assert(tables()[index]->get_type() == typeid(T));
+               return AstAttributeKey<T>(index);
+             }
+
+          static bool isKeyRegistered ( const std::string & name ) { return findKey(name) < (unsigned int)tables().size(); }
+
+          template <class T>
+          static const T & get ( const SgNode* node, AstAttributeKey<T> key )
+             {
+               return values(key).get(validNodeId(node));
+             }
+
+          template <class T>
+          static T & reference ( const SgNode* node, AstAttributeKey<T> key )
+             {
+               return values(key).reference(validNodeId(node));
+             }
+
+          template <class T>
+          static void set ( const SgNode* node, AstAttributeKey<T> key, const T & value )
+             {
+               values(key).reference(validNodeId(node)) = value;
+             }
+
+          template <class T>
+          static bool exists ( const SgNode* node, AstAttributeKey<T> key )
+             {
+               return values(key).exists(validNodeId(node));
+             }
+
+          template <class T>
+          static void remove ( const SgNode* node, AstAttributeKey<T> key )
+             {
+               values(key).erase(validNodeId(node));
+             }
+
+       // Releases the storage of all values of the key (the key stays registered).
+          template <class T>
+          static void clear ( AstAttributeKey<T> key )
+             {
+               values(key).clear();
+             }
+
+       // Bytes used by the table of the key.
+          template <class T>
+          static size_t memoryUsage ( AstAttributeKey<T> key )
+             {
+               return values(key).memoryUsage();
+             }
+
+       // Called from the destructor of SgNode, since the id of the node will be reused.
+          static void eraseNode ( const SgNode* node );
+
+     private:
+          static std::vector<AstAttributeSlotTable*> & tables ();
+          static unsigned int findKey ( const std::string & name );
+
+          static size_t validNodeId ( const SgNode* node )
+             {
+               size_t nodeId = AstMemoryPoolNodeId::nodeId(node);
+               assert(nodeId != AstMemoryPoolNodeId::invalidNodeId);
+               return nodeId;
+             }
+
+          template <class T>
+          static AstAttributeSlotValues<T> & values ( AstAttributeKey<T> key )
+             {
+               assert(key.get_index() < tables().size());
+               return *static_cast<AstAttributeSlotValues<T>*>(tables()[key.get_index()]);
+             }
+   };
+
+#endif
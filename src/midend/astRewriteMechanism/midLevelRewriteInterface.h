@@ -335,6 +335,12 @@ class ROSE_DLL_API MidLevelRewrite
           static typename ASTNodeCollection::NodeCollectionType 
                fileStringToNodeCollection ( SgNode* astNode, std::string transformationString );
 
+       // The two parts of fileStringToNodeCollection(): compile the intermediate file, then 
+       // separate the AST fragments found in (a subtree of) the intermediate file's AST.
+          static SgSourceFile* fileStringToSourceFile ( SgNode* astNode, std::string transformationString );
+          static typename ASTNodeCollection::NodeCollectionType 
+               subtreeToNodeCollection ( SgNode* astNode, SgNode* intermediateFileSubtree );
+
      public:
        // We set the default to generate #include directives instead of all the 
        // declarations from all system files (which can sometimes fail to unparse).
@@ -369,6 +375,15 @@ class ROSE_DLL_API MidLevelRewrite
       //! remove member function implemented using lower level remove member function
           static void remove  ( SgStatement* target );
 
+      //! Between beginBatch() and endBatch() insert() (and so replace()) only records the 
+      //! requests; endBatch() compiles all requests sharing the same prefix and suffix (the 
+      //! same position in the same non-global scope) as a single intermediate file and then 
+      //! inserts the AST fragments in the order the requests were made.  Requests in a batch 
+      //! must not depend on declarations added by other requests of the same batch, and a 
+      //! target must not be removed (replaced) before the last request using it.
+          static void beginBatch ();
+          static void endBatch ();
+
       //! Wraps macro calls so that they are understood in the intermediate files where 
       //! they specify transformations but not expanded until the final source code is 
       //! generated.
@@ -537,6 +537,9 @@ class MidLevelInterfaceNodeCollection : public AbstractInterfaceNodeCollection<M
 
           std::string generateIntermediateFileString ( SgNode* astNode, bool prefixIncludesCurrentStatement );
 
+      //! Sorted transformation strings wrapped in their marker declarations (intermediate file minus prefix and suffix)
+          std::string generateMarkedTransformationString ();
+
           void insertContainerOfListsOfStatements ( SgStatement* astNode );
 
           static void insertStatementList ( 
@@ -560,6 +563,9 @@ class MidLevelInterfaceNodeCollection : public AbstractInterfaceNodeCollection<M
 
           void writeAllChangeRequests ( SgStatement* target, bool prefixIncludesCurrentStatement );
 
+      //! Inserts the AST fragments already compiled into treeFragement (second half of writeAllChangeRequests())
+          void insertTreeFragments ( SgStatement* target, bool runConsistencyTests );
+
      private:
 //        static string positionName ( IntermediateFileStringPositionEnum i );
 
@@ -283,6 +283,21 @@ MidLevelRewrite<ASTNodeCollection>::fileStringToNodeCollection (
   // given scope (or subset of a scope or specific transformation) and separates the statements and
   // expressions into the ASTFragmentCollection object.
 
+     SgSourceFile* transformationASTPointer = fileStringToSourceFile(astNode,transformationString);
+     ROSE_ASSERT (transformationASTPointer != NULL);
+
+     return subtreeToNodeCollection(astNode,transformationASTPointer);
+   }
+
+template <class ASTNodeCollection>
+SgSourceFile*
+MidLevelRewrite<ASTNodeCollection>::fileStringToSourceFile ( 
+     SgNode* astNode, 
+     std::string transformationString )
+   {
+  // This function writes the intermediate file and compiles it (using the commandline 
+  // of the project containing astNode) to generate the AST of the intermediate file.
+
      ROSE_ASSERT (astNode!= NULL);
 
   // The project node is required so that we can recover the original 
@@ -379,6 +394,23 @@ MidLevelRewrite<ASTNodeCollection>::fileStringToNodeCollection (
      astdotgen.generateInputFiles(project,DOTGeneration<SgNode*>::TOPDOWNBOTTOMUP,dotfilename);
 #endif
 
+     return transformationASTPointer;
+   }
+
+template <class ASTNodeCollection>
+typename ASTNodeCollection::NodeCollectionType
+MidLevelRewrite<ASTNodeCollection>::subtreeToNodeCollection ( 
+     SgNode* astNode, 
+     SgNode* intermediateFileSubtree )
+   {
+  // This function separates the AST fragments embedded (between the marker declarations) in 
+  // a subtree of the intermediate file's AST.  The subtree is normally the whole SgSourceFile, 
+  // but it is a single SgBasicBlock when several requests were compiled together (see 
+  // MidLevelRewrite<MidLevelInterfaceNodeCollection>::endBatch()).
+
+     ROSE_ASSERT (astNode != NULL);
+     ROSE_ASSERT (intermediateFileSubtree != NULL);
+
   // At this point the transformation has been placed into the global scope and
   // we have to extract it into a form more useful to use (ready to substitute)
   // Ultimately we require more generality than this. The stripAwayWrapping() 
@@ -397,7 +429,7 @@ MidLevelRewrite<ASTNodeCollection>::fileStringToNodeCollection (
 
 #if 1
   // Call the tree traversal
-     synthesizedAttribute = treeTraversal.traverse(transformationASTPointer,inheritedValue);
+     synthesizedAttribute = treeTraversal.traverse(intermediateFileSubtree,inheritedValue);
 #else
   // AST_FragmentIdentificationSynthesizedAttributeType synthesizedAttribute;
      printf ("ERROR: Must call tree traversal! \n");
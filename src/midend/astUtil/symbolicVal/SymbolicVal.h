@@ -34,9 +34,43 @@ typedef enum {VAL_BASE = 0, VAL_CONST = 1, VAL_VAR = 2, VAL_AST = 4,
 typedef enum { SYMOP_NIL = 0, SYMOP_MULTIPLY=1, SYMOP_PLUS = 2,
                SYMOP_MIN=3, SYMOP_MAX=4, SYMOP_POW = 5} SymOpType;
 
+// Sharing of symbolic values: constants and variables are interned, so equal
+// ones share one SymbolicValImpl and compare by pointer (SymbolicVal::IsSame);
+// the simplified results of symbolic + and * are memoized by the identity of
+// their operands. Shared values are copy-on-write through CountRefHandle.
+class SymbolicVal;
+class ROSE_DLL_API SymbolicValCache
+{
+  static unsigned long allocations, internLookups, internHits, opLookups, opHits;
+  static bool enabled;
+ public:
+  // Interning and memoization can be turned off (e.g. to check that they do
+  // not change any result); values already shared stay shared
+  static void Enable( bool on) { enabled = on; }
+  static bool IsEnabled() { return enabled; }
+  static void CountAllocation() { ++allocations; }
+  static void CountInternLookup( bool hit) 
+     { ++internLookups; if (hit) ++internHits; }
+  static unsigned long NumOfAllocations() { return allocations; }
+
+  // Memoized results of SYMOP_PLUS and SYMOP_MULTIPLY
+  static bool LookupOp( SymOpType t, const SymbolicVal& v1, 
+                        const SymbolicVal& v2, SymbolicVal& result);
+  static void InsertOp( SymOpType t, const SymbolicVal& v1, 
+                        const SymbolicVal& v2, const SymbolicVal& result);
+
+  // Releases the interned values and memoized results (values still in use 
+  // are not affected)
+  static void Clear();
+  static std:: string toString();
+};
+
 class SymbolicValImpl 
 {
  protected:
+  SymbolicValImpl() { SymbolicValCache::CountAllocation(); }
+  SymbolicValImpl( const SymbolicValImpl&) 
+     { SymbolicValCache::CountAllocation(); }
   virtual ~SymbolicValImpl() {}
  public:
   virtual std:: string toString() const { return ""; }
@@ -144,10 +178,9 @@ class ROSE_DLL_API SymbolicVal : public CountRefHandle <SymbolicValImpl>
 {
  public:
   SymbolicVal() {}
-  SymbolicVal( SymbolicValImpl* _impl)
-    : CountRefHandle <SymbolicValImpl>(_impl) {}
-  SymbolicVal( const SymbolicValImpl& _impl)
-    : CountRefHandle <SymbolicValImpl>(_impl) {}
+  // Constants and variables are replaced by their interned representation
+  SymbolicVal( SymbolicValImpl* _impl);
+  SymbolicVal( const SymbolicValImpl& _impl);
   SymbolicVal (int val) ;
   SymbolicVal( const SymbolicVal& that)
    : CountRefHandle <SymbolicValImpl>(that) {}
@@ -160,6 +193,7 @@ class ROSE_DLL_API SymbolicVal : public CountRefHandle <SymbolicValImpl>
      { return ConstPtr() == that.ConstPtr(); }
   bool IsSame( const SymbolicValImpl& impl) const
      { return ConstPtr() == &impl; }
+  const SymbolicValImpl* GetImpl() const { return ConstPtr(); }
   AstNodePtr CodeGen(AstInterface &fa) const
      { return (ConstPtr()==0)? AstNodePtr(AST_NULL) : ConstRef().CodeGen(fa); }
   void Visit( SymbolicVisitor *op) const 
@@ -1,6 +1,8 @@
 #ifndef ROSE_BinaryAnalysis_ControlFlow_H
 #define ROSE_BinaryAnalysis_ControlFlow_H
 
+#include "BinaryCompactGraph.h"
+
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/depth_first_search.hpp>
 
@@ -139,6 +141,13 @@ namespace BinaryAnalysis {
                                       boost::bidirectionalS,
                                       boost::property<boost::vertex_name_t, SgAsmBlock*> > Graph;
 
+        /** Compact control flow graph type.
+         *
+         *  A graph in compressed sparse row form that can be used in place of Graph.  It needs much less memory and is
+         *  faster to traverse for very large functions or interpretations, but adding individual edges is slow.  See
+         *  BinaryAnalysis::CompactGraph. */
+        typedef BinaryAnalysis::CompactGraph CompactGraph;
+
         /**********************************************************************************************************************
          *                                      Filters
          **********************************************************************************************************************/
@@ -330,8 +339,22 @@ namespace BinaryAnalysis {
             VertexList *forward_order;
             FlowOrder(VertexList *forward_order): forward_order(forward_order) {}
             void compute(const ControlFlowGraph &g, Vertex v0, ReverseVertexList *reverse_order);
-            void finish_vertex(Vertex v, ControlFlowGraph g);
+            void finish_vertex(Vertex v, const ControlFlowGraph &g);
         };
+
+        /* Adds (source, target) edges to a graph.  Graph construction collects the edges first so that a CompactGraph can
+         * insert them all at once. */
+        template<class ControlFlowGraph>
+        static void add_edges(ControlFlowGraph &cfg,
+                              const std::vector<std::pair<typename boost::graph_traits<ControlFlowGraph>::vertex_descriptor,
+                                                          typename boost::graph_traits<ControlFlowGraph>::vertex_descriptor> >
+                              &edges) {
+            for (size_t i=0; i<edges.size(); ++i)
+                add_edge(edges[i].first, edges[i].second, cfg);
+        }
+        static void add_edges(CompactGraph &cfg, const std::vector<std::pair<CompactGraph::Vertex, CompactGraph::Vertex> > &edges) {
+            cfg.add_edges(edges);
+        }
             
         /* Helper class for build_cfg_from_ast().  Adds vertices to its 'cfg' member. Vertices are any SgAsmBlock that contains
          * at least one SgAsmInstruction. */
@@ -414,7 +437,7 @@ namespace BinaryAnalysis {
             typedef std::vector<Vertex> Vector;
             Vector &blocks;
             ReturnBlocks(Vector &blocks): blocks(blocks) {}
-            void finish_vertex(Vertex v, ControlFlowGraph g);
+            void finish_vertex(Vertex v, const ControlFlowGraph &g);
         };
 
     public:
@@ -493,6 +516,7 @@ BinaryAnalysis::ControlFlow::build_cfg_from_ast(SgNode *root, ControlFlowGraph &
     VertexInserter<ControlFlowGraph>(this, cfg, bv_map).traverse(root, preorder);
 
     /* Add the edges. */
+    std::vector<std::pair<Vertex, Vertex> > edges;
     typename boost::graph_traits<ControlFlowGraph>::vertex_iterator vi, vi_end;
     for (boost::tie(vi, vi_end)=vertices(cfg); vi!=vi_end; ++vi) {
         SgAsmBlock *source = boost::get(boost::vertex_name, cfg, *vi);
@@ -502,10 +526,11 @@ BinaryAnalysis::ControlFlow::build_cfg_from_ast(SgNode *root, ControlFlowGraph &
             if (target && !is_edge_filtered(source, target)) {
                 typename BlockVertexMap::iterator bvmi=bv_map.find(target);
                 if (bvmi!=bv_map.end())
-                    add_edge(*vi, bvmi->second, cfg);
+                    edges.push_back(std::make_pair(*vi, bvmi->second));
             }
         }
     }
+    add_edges(cfg, edges);
 }
 
 template<class ControlFlowGraph>
@@ -556,15 +581,17 @@ BinaryAnalysis::ControlFlow::copy(const ControlFlowGraph &src, ControlFlowGraph
         }
     }
 
+    std::vector<std::pair<Vertex, Vertex> > dst_edges;
     typename boost::graph_traits<ControlFlowGraph>::edge_iterator ei, ei_end;
     for (boost::tie(ei, ei_end)=edges(src); ei!=ei_end; ++ei) {
         if (NO_VERTEX!=src_to_dst[source(*ei, src)] && NO_VERTEX!=src_to_dst[target(*ei, src)]) {
             SgAsmBlock *block1 = get(boost::vertex_name, src, source(*ei, src));
             SgAsmBlock *block2 = get(boost::vertex_name, src, target(*ei, src));
             if (!is_edge_filtered(block1, block2))
-                add_edge(src_to_dst[source(*ei, src)], src_to_dst[target(*ei, src)], dst);
+                dst_edges.push_back(std::make_pair(src_to_dst[source(*ei, src)], src_to_dst[target(*ei, src)]));
         }
     }
+    add_edges(dst, dst_edges);
 }
 
 template<class ControlFlowGraph>
@@ -595,7 +622,7 @@ BinaryAnalysis::ControlFlow::FlowOrder<ControlFlowGraph>::compute(const ControlF
 
 template<class ControlFlowGraph>
 void
-BinaryAnalysis::ControlFlow::FlowOrder<ControlFlowGraph>::finish_vertex(Vertex v, ControlFlowGraph g) {
+BinaryAnalysis::ControlFlow::FlowOrder<ControlFlowGraph>::finish_vertex(Vertex v, const ControlFlowGraph &g) {
     forward_order->push_back(v);
 }
 
@@ -612,7 +639,7 @@ BinaryAnalysis::ControlFlow::flow_order(const ControlFlowGraph &cfg,
 
 template<class ControlFlowGraph>
 void
-BinaryAnalysis::ControlFlow::ReturnBlocks<ControlFlowGraph>::finish_vertex(Vertex v, ControlFlowGraph g)
+BinaryAnalysis::ControlFlow::ReturnBlocks<ControlFlowGraph>::finish_vertex(Vertex v, const ControlFlowGraph &g)
 {
     typename boost::graph_traits<ControlFlowGraph>::out_edge_iterator ei, ei_end;
     boost::tie(ei, ei_end) = out_edges(v, g);
@@ -92,7 +92,17 @@ namespace BinaryAnalysis {
      */
     class Dominance {
     public:
-        Dominance(): debug(NULL) {}
+        /** Algorithms for calculating immediate dominators.  See set_algorithm(). */
+        enum Algorithm {
+            ALGORITHM_AUTO,             /**< SEMI-NCA for CFGs having at least AUTO_THRESHOLD vertices, iterative otherwise. */
+            ALGORITHM_ITERATIVE,        /**< Cooper-Harvey-Kennedy iterative data flow algorithm. */
+            ALGORITHM_SEMI_NCA          /**< Lengauer-Tarjan semidominators followed by nearest common ancestor search. */
+        };
+
+        /** Number of CFG vertices at which ALGORITHM_AUTO switches from the iterative algorithm to SEMI-NCA. */
+        static const size_t AUTO_THRESHOLD = 1000;
+
+        Dominance(): debug(NULL), algorithm(ALGORITHM_AUTO) {}
 
         /** The default dominance graph type.
          *
@@ -240,7 +250,9 @@ namespace BinaryAnalysis {
          *  D. Cooper, Timothy J. Harvey, and Ken Kennedy at Rice University, Houston, Texas.  It has been extended in various
          *  ways to simplify it and make it slightly faster.  Although run-time complexity is higher than the Lengauer-Tarjan
          *  algorithm, the algorithm is much simpler, and for CFGs typically encountered in practice is faster than
-         *  Lengauer-Tarjan.
+         *  Lengauer-Tarjan.  For large CFGs (e.g., obfuscated functions with many thousands of basic blocks) the quadratic
+         *  behavior dominates, and the SEMI-NCA algorithm is used instead; see set_algorithm().  Both algorithms produce the
+         *  same relation.
          *
          *  @{ */
         template<class ControlFlowGraph>
@@ -254,6 +266,21 @@ namespace BinaryAnalysis {
                                           RelationMap<ControlFlowGraph> &idom/*out*/);
         /** @} */
 
+    protected:
+        /* Depth-first search stack frame for build_idom_relation_semi_nca(). */
+        template<class OutEdgeIterator>
+        struct DfsFrame {
+            size_t number;                      /* preorder number of the vertex */
+            OutEdgeIterator cur, end;           /* out edges not yet followed */
+        };
+
+        /* The SEMI-NCA implementation of build_idom_relation_from_cfg(). */
+        template<class ControlFlowGraph>
+        void build_idom_relation_semi_nca(const ControlFlowGraph &cfg,
+                                          typename boost::graph_traits<ControlFlowGraph>::vertex_descriptor start,
+                                          RelationMap<ControlFlowGraph> &idom/*out*/);
+    public:
+
 
         /** Builds a relation map for immediate post dominator.
          *
@@ -397,8 +424,21 @@ namespace BinaryAnalysis {
          *  disabled. */
         FILE *get_debug() const { return debug; }
 
+        /** Property: immediate dominator algorithm.
+         *
+         *  The Cooper-Harvey-Kennedy iterative algorithm is quadratic in the worst case, while the SEMI-NCA algorithm ("Finding
+         *  Dominators in Practice" by Loukas Georgiadis, Renato F. Werneck, Robert E. Tarjan, Spyridon Triantafyllis and
+         *  David I. August) is O(E log V) for the semidominators plus a nearest common ancestor pass that is linear in
+         *  practice.  The default, ALGORITHM_AUTO, picks by CFG size.
+         *
+         *  @{ */
+        void set_algorithm(Algorithm algorithm) { this->algorithm = algorithm; }
+        Algorithm get_algorithm() const { return algorithm; }
+        /** @} */
+
     protected:
         FILE *debug;                    /**< Debugging stream, or null. */
+        Algorithm algorithm;            /**< Algorithm used by build_idom_relation_from_cfg(). */
     };
 }
 
@@ -545,6 +585,11 @@ BinaryAnalysis::Dominance::build_idom_relation_from_cfg(const ControlFlowGraph &
         }
     };
 
+    if (ALGORITHM_SEMI_NCA==algorithm || (ALGORITHM_AUTO==algorithm && num_vertices(cfg)>=AUTO_THRESHOLD)) {
+        build_idom_relation_semi_nca(cfg, start, result);
+        return;
+    }
+
     if (debug) {
         fprintf(debug, "BinaryAnalysis::Dominance::build_idom_relation_from_cfg: starting at vertex %zu\n", start);
         SgAsmBlock *block = get(boost::vertex_name, cfg, start);
@@ -695,6 +740,115 @@ BinaryAnalysis::Dominance::build_idom_relation_from_cfg(const ControlFlowGraph &
     }
 }
 
+/* SEMI-NCA, from "Finding Dominators in Practice" (Georgiadis et al.).  Vertices reachable from the start vertex are numbered
+ * in depth-first preorder, and the semidominator of each vertex is computed in reverse preorder with the link-eval forest of
+ * Lengauer-Tarjan (simple linking with path compression).  The immediate dominator of W is then the nearest common ancestor,
+ * in the dominator tree built so far, of W's DFS parent and W's semidominator: walk up from the parent until reaching a
+ * vertex whose preorder number is not greater than the semidominator's.
+ *
+ * All arrays are indexed by preorder number. Both the depth-first search and the path compression are iterative since
+ * the CFGs for which this algorithm is chosen are much deeper than the run-time stack. */
+template<class ControlFlowGraph>
+void
+BinaryAnalysis::Dominance::build_idom_relation_semi_nca(const ControlFlowGraph &cfg,
+                                                        typename boost::graph_traits<ControlFlowGraph>::vertex_descriptor start,
+                                                        RelationMap<ControlFlowGraph> &result)
+{
+    typedef typename boost::graph_traits<ControlFlowGraph>::vertex_descriptor CFG_Vertex;
+    typedef typename boost::graph_traits<ControlFlowGraph>::out_edge_iterator OutEdgeIterator;
+    typedef typename boost::graph_traits<ControlFlowGraph>::in_edge_iterator InEdgeIterator;
+    static const size_t NONE = (size_t)(-1);
+    size_t nverts = num_vertices(cfg);
+
+    if (debug)
+        fprintf(debug, "BinaryAnalysis::Dominance::build_idom_relation_semi_nca: starting at vertex %zu\n", (size_t)start);
+
+    /* Depth-first preorder numbering */
+    typedef DfsFrame<OutEdgeIterator> Frame;
+    std::vector<size_t> number(nverts, NONE);           /* preorder number of each CFG vertex; NONE if unreachable */
+    std::vector<CFG_Vertex> vertex;                     /* CFG vertex of each preorder number */
+    std::vector<size_t> parent;                         /* preorder number of DFS tree parent */
+    std::vector<Frame> stack;
+    number[start] = 0;
+    vertex.push_back(start);
+    parent.push_back(0);
+    stack.push_back(Frame());
+    stack.back().number = 0;
+    boost::tie(stack.back().cur, stack.back().end) = out_edges(start, cfg);
+    while (!stack.empty()) {
+        if (stack.back().cur==stack.back().end) {
+            stack.pop_back();
+            continue;
+        }
+        CFG_Vertex w = target(*stack.back().cur++, cfg);
+        if (NONE==number[w]) {
+            number[w] = vertex.size();
+            parent.push_back(stack.back().number);
+            vertex.push_back(w);
+            stack.push_back(Frame());
+            stack.back().number = number[w];
+            boost::tie(stack.back().cur, stack.back().end) = out_edges(w, cfg);
+        }
+    }
+
+    /* Semidominators */
+    size_t n = vertex.size();
+    std::vector<size_t> semi(n), label(n), ancestor(n, NONE), path;
+    for (size_t i=0; i<n; ++i)
+        semi[i] = label[i] = i;
+    for (size_t w=n-1; w>0; --w) {
+        InEdgeIterator pi, pi_end;
+        for (boost::tie(pi, pi_end)=in_edges(vertex[w], cfg); pi!=pi_end; ++pi) {
+            size_t v = number[source(*pi, cfg)];
+            if (NONE==v)
+                continue;                               /* predecessor not reachable from start */
+            size_t u = v;
+            if (NONE!=ancestor[v]) {
+                /* eval(v): compress the path from v to the root of its link-eval tree */
+                path.clear();
+                for (size_t x=v; NONE!=ancestor[ancestor[x]]; x=ancestor[x])
+                    path.push_back(x);
+                while (!path.empty()) {
+                    size_t x = path.back(), a = ancestor[x];
+                    path.pop_back();
+                    if (semi[label[a]] < semi[label[x]])
+                        label[x] = label[a];
+                    ancestor[x] = ancestor[a];
+                }
+                u = label[v];
+            }
+            if (semi[u] < semi[w])
+                semi[w] = semi[u];
+        }
+        ancestor[w] = parent[w];                        /* link(parent[w], w) */
+    }
+
+    /* Immediate dominators */
+    std::vector<size_t> idom(n, 0);
+    for (size_t w=1; w<n; ++w) {
+        size_t d = parent[w];
+        while (d > semi[w])
+            d = idom[d];
+        idom[w] = d;
+    }
+
+    result.clear();
+    result.resize(nverts, boost::graph_traits<ControlFlowGraph>::null_vertex());
+    for (size_t w=1; w<n; ++w)
+        result[vertex[w]] = vertex[idom[w]];
+
+    if (debug) {
+        fprintf(debug, "  Final result:\n");
+        for (size_t i=0; i<result.size(); i++) {
+            if (result[i]==boost::graph_traits<ControlFlowGraph>::null_vertex()) {
+                fprintf(debug, "    CFG vertex %zu has no immediate dominator\n", i);
+            } else {
+                fprintf(debug, "    CFG vertex %zu has immediate dominator %zu\n", i, (size_t)result[i]);
+            }
+        }
+    }
+}
+
 
 
 
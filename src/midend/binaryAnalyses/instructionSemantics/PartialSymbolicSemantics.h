@@ -243,11 +243,13 @@ namespace BinaryAnalysis {                      // documented elsewhere
                                                      *   startInstruction(), which is the first thing called by
                                                      *   X86InstructionSemantics::processInstruction(). */
                 MemoryMap *map;                     /**< Initial known memory values for known addresses. */
+                bool cleared;                       /**< True if interrupt() or sysenter() discarded the entire current state
+                                                     *   since the first instruction was processed.  See compose(). */
 
             public:
                 typedef State<ValueType> StateType;
 
-                Policy(): cur_insn(NULL), p_discard_popped_memory(false), ninsns(0), map(NULL) {
+                Policy(): cur_insn(NULL), p_discard_popped_memory(false), ninsns(0), map(NULL), cleared(false) {
                     /* So that named values are identical in both; reinitialized by first call to startInstruction(). */
                     set_register_dictionary(RegisterDictionary::dictionary_pentium4());
                     orig_state = cur_state;
@@ -317,6 +319,21 @@ namespace BinaryAnalysis {                      // documented elsewhere
                  *  stack pointer need not have a known value. */
                 bool on_stack(const ValueType<32> &value) const;
 
+                /** Applies the effect of the instructions processed by another policy to this policy's current state.
+                 *
+                 *  The @p other policy's original and current states together summarize a sequence of instructions (usually a
+                 *  basic block) as a transfer function: each named value of its original state stands for whatever the
+                 *  corresponding register or memory location holds on entry.  Composing replaces those names with values from
+                 *  this policy's current state, gives new names to the values the instructions created, and then performs the
+                 *  register assignments and memory writes of the other policy's final state.  The result is the same as
+                 *  processing the other policy's instructions here, except that memory may be less precise: aliasing between
+                 *  the other policy's memory accesses was decided without knowing the values in this state, so a read that
+                 *  might have been aliased there yields a new value here.  The two policies should use the same memory map.
+                 *
+                 *  This allows the effect of a basic block to be computed once and then applied many times; a cached summary
+                 *  of a block is much cheaper to apply than re-processing its instructions. */
+                void compose(const Policy &other);
+
                 /** Changes how the policy treats the stack.  See the p_discard_popped_memory property data member for
                  *  details. */
                 void set_discard_popped_memory(bool b) {
@@ -442,6 +459,40 @@ namespace BinaryAnalysis {                      // documented elsewhere
                     return new_cell.get_data();
                 }
 
+                /** Replacement values used by compose(), indexed by the name of a value in the other policy. */
+                typedef std::map<uint64_t, ValueType<32> > Substitution;
+
+                /** Expresses a value of the other policy in terms of this policy's values. Names not present in the
+                 *  substitution were created by the other policy's instructions and are given new names. Used by compose(). */
+                template <size_t Len>
+                ValueType<Len> substitute(const ValueType<Len> &value, Substitution &subst) const {
+                    if (!value.name)
+                        return value;
+                    typename Substitution::iterator found = subst.find(value.name);
+                    if (found==subst.end())
+                        found = subst.insert(std::make_pair(value.name, ValueType<32>())).first;
+                    const ValueType<32> &base = found->second;
+                    uint64_t offset = (value.negate ? -base.offset : base.offset) + value.offset;
+                    if (!base.name)
+                        return ValueType<Len>(offset);
+                    return ValueType<Len>(base.name, offset, value.negate!=base.negate);
+                }
+
+                /** Adds a substitution for the name of @p orig, which is an original value of the other policy, so that @p orig
+                 *  becomes @p actual. Names that are already substituted are left alone.  Used by compose(). */
+                template <size_t Len>
+                void bind(const ValueType<Len> &orig, const ValueType<Len> &actual, Substitution &subst) const {
+                    if (!orig.name || subst.find(orig.name)!=subst.end())
+                        return;
+                    /* orig is +/-name+offset, so name is +/-(actual-offset) */
+                    uint64_t offset = orig.negate ? orig.offset - actual.offset : actual.offset - orig.offset;
+                    if (!actual.name) {
+                        subst[orig.name] = ValueType<32>(offset);
+                    } else {
+                        subst[orig.name] = ValueType<32>(actual.name, offset, actual.negate!=orig.negate);
+                    }
+                }
+
                 /** See memory_reference_type(). */
                 enum MemRefType { MRT_STACK_PTR, MRT_FRAME_PTR, MRT_OTHER_PTR };
 
@@ -577,11 +628,13 @@ namespace BinaryAnalysis {                      // documented elsewhere
                 /** See NullSemantics::Policy::interrupt() */
                 void interrupt(uint8_t num) {
                     cur_state = State<ValueType>(); /*reset entire machine state*/
+                    cleared = true;
                 }
 
                 /** See NullSemantics::Policy::sysenter() */
                 void sysenter() {
                     cur_state = State<ValueType>(); /*reset entire machine state*/
+                    cleared = true;
                 }
 
 
@@ -1115,6 +1168,89 @@ namespace BinaryAnalysis {                      // documented elsewhere
                 return false;
             }
 
+            template<
+                template <template <size_t> class ValueType> class State,
+                template<size_t> class ValueType>
+            void
+            Policy<State, ValueType>::compose(const Policy &other)
+            {
+#ifndef CXX_IS_ROSE_ANALYSIS
+                if (0==other.ninsns)
+                    return;
+                if (0==ninsns)
+                    orig_state = cur_state;
+                ninsns += other.ninsns;
+
+                /* Bind the other policy's original values to ours.  Registers first, then memory in the order it was first
+                 * read, since an address can only depend on registers and on values read earlier. */
+                Substitution subst;
+                for (size_t i=0; i<cur_state.registers.n_gprs; ++i)
+                    bind(other.orig_state.registers.gpr[i], cur_state.registers.gpr[i], subst);
+                for (size_t i=0; i<cur_state.registers.n_segregs; ++i)
+                    bind(other.orig_state.registers.segreg[i], cur_state.registers.segreg[i], subst);
+                for (size_t i=0; i<cur_state.registers.n_flags; ++i)
+                    bind(other.orig_state.registers.flag[i], cur_state.registers.flag[i], subst);
+                bind(other.orig_state.registers.ip, cur_state.registers.ip, subst);
+                for (typename State<ValueType>::Memory::const_iterator mi=other.orig_state.memory.begin();
+                     mi!=other.orig_state.memory.end(); ++mi) {
+                    const ValueType<32> &data = mi->get_data();
+                    if (!data.name || subst.find(data.name)!=subst.end())
+                        continue;
+                    ValueType<32> addr = substitute(mi->get_address(), subst);
+                    switch (mi->get_nbytes()) {
+                        case 1: bind(data, ValueType<32>(mem_read<8>(cur_state, addr)), subst); break;
+                        case 2: bind(data, ValueType<32>(mem_read<16>(cur_state, addr)), subst); break;
+                        case 4: bind(data, mem_read<32>(cur_state, addr), subst); break;
+                        default: ROSE_ASSERT(!"unexpected memory cell size");
+                    }
+                }
+
+                /* Compute the new values before changing anything. */
+                State<ValueType> result;
+                for (size_t i=0; i<cur_state.registers.n_gprs; ++i)
+                    result.registers.gpr[i] = substitute(other.cur_state.registers.gpr[i], subst);
+                for (size_t i=0; i<cur_state.registers.n_segregs; ++i)
+                    result.registers.segreg[i] = substitute(other.cur_state.registers.segreg[i], subst);
+                for (size_t i=0; i<cur_state.registers.n_flags; ++i)
+                    result.registers.flag[i] = substitute(other.cur_state.registers.flag[i], subst);
+                result.registers.ip = substitute(other.cur_state.registers.ip, subst);
+                for (typename State<ValueType>::Memory::const_iterator mi=other.cur_state.memory.begin();
+                     mi!=other.cur_state.memory.end(); ++mi) {
+                    if (mi->is_written()) {
+                        MemoryCell<ValueType> cell(substitute(mi->get_address(), subst), substitute(mi->get_data(), subst),
+                                                   mi->get_nbytes());
+                        cell.set_clobbered(mi->is_clobbered());
+                        result.memory.push_back(cell);
+                    }
+                }
+
+                /* Update our state. Writes that were later clobbered are replayed first (with unknown values) so that they
+                 * clobber what they alias here; the remaining writes cannot alias one another, or they would have been
+                 * clobbered in the other policy. */
+                if (other.cleared) {
+                    cur_state = State<ValueType>();
+                    cleared = true;
+                }
+                cur_state.registers = result.registers;
+                for (int pass=0; pass<2; ++pass) {
+                    for (typename State<ValueType>::Memory::const_iterator mi=result.memory.begin();
+                         mi!=result.memory.end(); ++mi) {
+                        if (mi->is_clobbered() != (0==pass))
+                            continue;
+                        ValueType<32> data = mi->is_clobbered() ? ValueType<32>() : mi->get_data();
+                        switch (mi->get_nbytes()) {
+                            case 1: mem_write<8>(cur_state, mi->get_address(), ValueType<8>(data)); break;
+                            case 2: mem_write<16>(cur_state, mi->get_address(), ValueType<16>(data)); break;
+                            case 4: mem_write<32>(cur_state, mi->get_address(), data); break;
+                            default: ROSE_ASSERT(!"unexpected memory cell size");
+                        }
+                    }
+                }
+                if (p_discard_popped_memory)
+                    cur_state.discard_popped_memory();
+#endif
+            }
+
             template<
                 template <template <size_t> class ValueType> class State,
                 template<size_t> class ValueType>
@@ -15,6 +15,7 @@
 #include <queue>
 #include <boost/foreach.hpp>
 #include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
 
 class FunctionData;
 
@@ -95,6 +96,12 @@ class ROSE_DLL_API FunctionData
 
     FunctionData(SgFunctionDeclaration* functionDeclaration, SgProject *project, ClassHierarchyWrapper * );
 
+    //! Records the function without resolving its callees; computeCallees() fills in functionList later.
+    explicit FunctionData(SgFunctionDeclaration* functionDeclaration);
+
+    //! Resolve all the call sites and constructor initializers in the function body into functionList.
+    void computeCallees(ClassHierarchyWrapper *classHierarchy);
+
     //! All the callees of this function
     Rose_STL_Container<SgFunctionDeclaration *> functionList;
 
@@ -126,6 +133,13 @@ class ROSE_DLL_API CallGraphBuilder
     //! Builder accepting user defined predicate to filter certain functions
     template<typename Predicate>
       void buildCallGraph(Predicate pred);
+    //! Re-resolve only the callees of the given functions (e.g. those whose bodies changed) and update
+    //! the graph built earlier in place. Functions not yet in the graph get new nodes, and the nodes of
+    //! functions that were deleted from the AST are removed; changedFunctions must not name deleted functions.
+    void updateCallGraph(const std::vector<SgFunctionDeclaration*>& changedFunctions);
+    //! Incremental update with the same predicate that was used to build the graph
+    template<typename Predicate>
+      void updateCallGraph(const std::vector<SgFunctionDeclaration*>& changedFunctions, Predicate pred);
     //! Grab the call graph built
     SgIncidenceDirectedGraph *getGraph(); 
     //void classifyCallGraph();
@@ -133,7 +147,29 @@ class ROSE_DLL_API CallGraphBuilder
     //We map each function to the corresponding graph node
     boost::unordered_map<SgFunctionDeclaration*, SgGraphNode*>& getGraphNodesMapping(){ return graphNodes; }
 
+    //! The declaration used to represent a function in the graph: the in-class declaration for member
+    //! functions, the first nondefining declaration otherwise
+    static SgFunctionDeclaration* getGraphNodeDeclaration(SgFunctionDeclaration* functionDeclaration);
+
   private:
+    //! Resolve the callees of every function in callGraphData, filling each FunctionData::functionList. When ROSE is
+    //! configured with OpenMP the functions are resolved concurrently, each thread filling only its own functionList.
+    static void computeCallees(Rose_STL_Container<FunctionData>& callGraphData, ClassHierarchyWrapper* classHierarchy);
+
+    //! Fill the caches that callee resolution would otherwise fill on first use (mangled names, unparsed member
+    //! function types, the types of the called expressions), so that the concurrent resolution only reads the AST.
+    static void prepareCalleeResolution(Rose_STL_Container<FunctionData>& callGraphData);
+
+    //! Remove the nodes (and their edges) of functions that are no longer in the AST
+    void removeDeletedFunctions();
+
+    //! Returns the node of the function, creating it if the function is not in the graph yet
+    SgGraphNode* getOrCreateGraphNode(SgFunctionDeclaration* functionDeclaration, bool isDefined);
+
+    //! Add the edges from each function to its callees, skipping filtered out callees and duplicates
+    template<typename Predicate>
+      int addCallEdges(Rose_STL_Container<FunctionData>& callGraphData, Predicate pred);
+
     SgProject *project;
     SgIncidenceDirectedGraph *graph;
     //We map each function to the corresponding graph node
@@ -164,37 +200,23 @@ CallGraphBuilder::buildCallGraph(Predicate pred)
 
     ClassHierarchyWrapper classHierarchy(project);
     Rose_STL_Container<SgNode *>::iterator i = allFunctions.begin();
+    boost::unordered_set<SgFunctionDeclaration*> seen;
 
     graphNodes.clear();
     
-    //Iterate through all the functions found and resolve all the call expressions in each function with a body
+    //Collect all the functions found; the call expressions are resolved afterwards for all of them at once
     while (i != allFunctions.end())
     {
         SgFunctionDeclaration* functionDeclaration = isSgFunctionDeclaration(*i);
         ROSE_ASSERT(functionDeclaration != NULL);
 
         // determining the in-class declaration
-        if (isSgMemberFunctionDeclaration(functionDeclaration))
-        {
-            // always saving the in-class declaration, so we need to find that one
-            SgDeclarationStatement *nonDefDeclInClass =
-                    isSgMemberFunctionDeclaration(functionDeclaration->get_firstNondefiningDeclaration());
-            // functionDeclaration is outside the class (so it must have a definition)
-            if (nonDefDeclInClass)
-                functionDeclaration = isSgMemberFunctionDeclaration(nonDefDeclInClass);
-        }
-        else
-        {
-            // we need to have only one declaration for regular functions as well
-            SgFunctionDeclaration *nonDefDecl = isSgFunctionDeclaration(functionDeclaration->get_firstNondefiningDeclaration());
-            if (nonDefDecl)
-                functionDeclaration = nonDefDecl;
-        }
+        functionDeclaration = getGraphNodeDeclaration(functionDeclaration);
 
         //AS(032806) Filter out functions based on criteria in predicate
-        if (pred(functionDeclaration) == true)
+        if (pred(functionDeclaration) == true && seen.insert(functionDeclaration).second)
         {
-            FunctionData functionData(functionDeclaration, project, &classHierarchy);
+            FunctionData functionData(functionDeclaration);
             ROSE_ASSERT(functionData.functionDeclaration != NULL);
 
             callGraphData.push_back(functionData);
@@ -202,43 +224,90 @@ CallGraphBuilder::buildCallGraph(Predicate pred)
         i++;
     }
 
+    // Resolve the call expressions in each function with a body
+    computeCallees(callGraphData, &classHierarchy);
+
     // Build the graph
-    SgIncidenceDirectedGraph *returnGraph = new SgIncidenceDirectedGraph();
-    ROSE_ASSERT(returnGraph != NULL);
+    graph = new SgIncidenceDirectedGraph();
+    ROSE_ASSERT(graph != NULL);
 
-    
     //Instantiate all the nodes in the graph, one for each function we found
     BOOST_FOREACH(FunctionData& currentFunction, callGraphData)
     {
-        std::string functionName;
         ROSE_ASSERT(currentFunction.functionDeclaration);
-        functionName = currentFunction.functionDeclaration->get_qualified_name().getString();
+        getOrCreateGraphNode(currentFunction.functionDeclaration, currentFunction.isDefined());
+    }
 
-        // Generate a unique name to test against later
-        SgFunctionDeclaration* id = currentFunction.functionDeclaration;
-        SgDeclarationStatement *nonDefDeclInClass = isSgMemberFunctionDeclaration(id->get_firstNondefiningDeclaration());
-        if (nonDefDeclInClass)
-            ROSE_ASSERT(id == nonDefDeclInClass);
-        SgGraphNode* graphNode = new SgGraphNode(functionName);
-        graphNode->set_SgNode(currentFunction.functionDeclaration);
+    if (SgProject::get_verbose() >= DIAGNOSTICS_VERBOSE_LEVEL)
+        std::cout << "NodeList size: " << graphNodes.size() << "\n";
+
+    //We have all the nodes. Now instantiate all the graph edges
+    int totEdges = addCallEdges(callGraphData, pred);
+    
+    if (SgProject::get_verbose() >= DIAGNOSTICS_VERBOSE_LEVEL)
+        std::cout << "Total number of edges: " << totEdges << "\n";
+}
 
-        if (SgProject::get_verbose() >= DIAGNOSTICS_VERBOSE_LEVEL)
+template<typename Predicate>
+  void
+CallGraphBuilder::updateCallGraph(const std::vector<SgFunctionDeclaration*>& changedFunctions, Predicate pred)
+{
+    // Nothing to update incrementally
+    if (graph == NULL)
+    {
+        buildCallGraph(pred);
+        return;
+    }
+
+    removeDeletedFunctions();
+
+    Rose_STL_Container<FunctionData> callGraphData;
+    boost::unordered_set<SgFunctionDeclaration*> seen;
+
+    BOOST_FOREACH(SgFunctionDeclaration* changedFunction, changedFunctions)
+    {
+        ROSE_ASSERT(changedFunction != NULL);
+        SgFunctionDeclaration* functionDeclaration = getGraphNodeDeclaration(changedFunction);
+
+        if (pred(functionDeclaration) == false || seen.insert(functionDeclaration).second == false)
+            continue;
+
+        FunctionData functionData(functionDeclaration);
+        callGraphData.push_back(functionData);
+
+        // Drop the edges computed from the old body; the incoming edges are still valid
+        boost::unordered_map<SgFunctionDeclaration*, SgGraphNode*>::iterator iter = graphNodes.find(functionDeclaration);
+        if (iter != graphNodes.end())
         {
-            std::cout << "Function: "
-                    << currentFunction.functionDeclaration->get_scope()->get_qualified_name().getString() +
-                    currentFunction.functionDeclaration->get_mangled_name().getString()
-                    << " has declaration " << currentFunction.isDefined() << "\n";
+            std::set<SgDirectedGraphEdge*> oldEdges = graph->computeEdgeSetOut(iter->second);
+            BOOST_FOREACH(SgDirectedGraphEdge* edge, oldEdges)
+            {
+                graph->removeDirectedEdge(edge);
+            }
         }
-        
-        graphNodes[currentFunction.functionDeclaration] = graphNode;
+    }
+
+    // The class hierarchy may have changed along with the bodies
+    ClassHierarchyWrapper classHierarchy(project);
+    computeCallees(callGraphData, &classHierarchy);
 
-        returnGraph->addNode(graphNode);
+    BOOST_FOREACH(FunctionData& currentFunction, callGraphData)
+    {
+        getOrCreateGraphNode(currentFunction.functionDeclaration, currentFunction.isDefined());
     }
 
+    int totEdges = addCallEdges(callGraphData, pred);
+
     if (SgProject::get_verbose() >= DIAGNOSTICS_VERBOSE_LEVEL)
-        std::cout << "NodeList size: " << graphNodes.size() << "\n";
+        std::cout << "Updated " << callGraphData.size() << " functions, number of edges added: " << totEdges << "\n";
+}
+
+template<typename Predicate>
+  int
+CallGraphBuilder::addCallEdges(Rose_STL_Container<FunctionData>& callGraphData, Predicate pred)
+{
+    ROSE_ASSERT(graph != NULL);
 
-    //We have all the nodes. Now instantiate all the graph edges
     int totEdges = 0;
     BOOST_FOREACH(FunctionData& currentFunction, callGraphData)
     {
@@ -249,41 +318,48 @@ CallGraphBuilder::buildCallGraph(Predicate pred)
         ROSE_ASSERT(iter != graphNodes.end());
         SgGraphNode* startingNode = iter->second;
 
+        // The old edges of startingNode were all removed or never existed, so duplicates can only
+        // come from this callee list
+        boost::unordered_set<SgGraphNode*> targets;
+
         Rose_STL_Container<SgFunctionDeclaration*> & functionCallees = currentFunction.functionList;
 
         BOOST_FOREACH(SgFunctionDeclaration* calleeDeclaration, functionCallees)
         {
-                        ROSE_ASSERT(calleeDeclaration != NULL);
-
-                        //This function has been filtered out
-                        if (pred(calleeDeclaration) == false)
-                        {
-                                continue;
-                        }
-
-                        iter = graphNodes.find(calleeDeclaration);
-                        ROSE_ASSERT(iter != graphNodes.end());
-                        SgGraphNode *endNode = iter->second;
-
-                        if (returnGraph->checkIfDirectedGraphEdgeExists(startingNode, endNode) == false)
-                        {
-                                ROSE_ASSERT(startingNode != NULL && endNode != NULL);
-                                returnGraph->addDirectedEdge(startingNode, endNode);
-                        }
-                        else if (SgProject::get_verbose() >= DIAGNOSTICS_VERBOSE_LEVEL)
-                        {
-                                std::cout << "Did not add edge since it already exist" << std::endl;
-                                std::cout << "\tEndNode " << calleeDeclaration->get_name().str() << "\n";
-                        }
+            ROSE_ASSERT(calleeDeclaration != NULL);
+
+            //This function has been filtered out
+            if (pred(calleeDeclaration) == false)
+            {
+                continue;
+            }
+
+            iter = graphNodes.find(calleeDeclaration);
+            SgGraphNode *endNode = NULL;
+            if (iter != graphNodes.end())
+                endNode = iter->second;
+            else
+            {
+                // Only possible after an incremental update, when a changed body calls a new function
+                endNode = getOrCreateGraphNode(calleeDeclaration, FunctionData(calleeDeclaration).isDefined());
+            }
+            ROSE_ASSERT(startingNode != NULL && endNode != NULL);
+
+            if (targets.insert(endNode).second)
+            {
+                graph->addDirectedEdge(startingNode, endNode);
+            }
+            else if (SgProject::get_verbose() >= DIAGNOSTICS_VERBOSE_LEVEL)
+            {
+                std::cout << "Did not add edge since it already exist" << std::endl;
+                std::cout << "\tEndNode " << calleeDeclaration->get_name().str() << "\n";
+            }
 
             totEdges++;
         }
     }
-    
-    if (SgProject::get_verbose() >= DIAGNOSTICS_VERBOSE_LEVEL)
-        std::cout << "Total number of edges: " << totEdges << "\n";
 
-    graph = returnGraph;
+    return totEdges;
 }
 
 // endif for CALL_GRAPH_H
@@ -87,9 +87,20 @@ void DefUseAnalysis::addUseElement(SgNode* sgNode,
 void DefUseAnalysis::addAnyElement(tabletype* tabl, SgNode* sgNode, 
                                 SgInitializedName* initName,
                                 SgNode* defNode) { 
+  if (isShard) {
+    addAnyElementUnlocked(tabl, sgNode, initName, defNode);
+    return;
+  }
 #if ROSE_GCC_OMP
 #pragma omp critical (DefUseAnalysisaddUseE) 
 #endif
+  addAnyElementUnlocked(tabl, sgNode, initName, defNode);
+}
+
+void DefUseAnalysis::addAnyElementUnlocked(tabletype* tabl, SgNode* sgNode, 
+                                SgInitializedName* initName,
+                                SgNode* defNode) { 
+  indexValid = false;
   //  (*tabl)[sgNode].insert(make_pair(initName, defNode));
   (*tabl)[sgNode].push_back(make_pair(initName, defNode));
    addID(sgNode);
@@ -110,10 +121,19 @@ void DefUseAnalysis::replaceElement(SgNode* sgNode,
   // if the node is contained but not identical, then we overwrite it
   // otherwise, we do nothing
   //table[sgNode].erase(table[sgNode].lower_bound(initName), table[sgNode].upper_bound(initName));
+  if (isShard) {
+    replaceElementUnlocked(sgNode, initName);
+    return;
+  }
 #if ROSE_GCC_OMP
 #pragma omp critical (DefUseAnalysisreplaceE1) 
 #endif
-  {
+  replaceElementUnlocked(sgNode, initName);
+}
+
+void DefUseAnalysis::replaceElementUnlocked(SgNode* sgNode, 
+                                    SgInitializedName* initName) {
+    indexValid = false;
     //table[sgNode].erase(initName);
     //    table[sgNode].insert(make_pair(initName,sgNode));
 
@@ -121,8 +141,7 @@ void DefUseAnalysis::replaceElement(SgNode* sgNode,
     map.erase(std::remove_if(map.begin(), map.end(), boost::bind(boost::type<bool>(), DefUseAnalysismycond, _1, initName)), map.end());
     //         table[sgNode].erase(it);
 
-    table[sgNode].push_back(make_pair(initName,sgNode));
-  }
+    map.push_back(make_pair(initName,sgNode));
 }
 
 /**********************************************************
@@ -130,16 +149,23 @@ void DefUseAnalysis::replaceElement(SgNode* sgNode,
  *********************************************************/
 void DefUseAnalysis::clearUseOfElement(SgNode* sgNode, 
                                     SgInitializedName* initName) {
+  if (isShard) {
+    clearUseOfElementUnlocked(sgNode, initName);
+    return;
+  }
 #if ROSE_GCC_OMP
 #pragma omp critical (DefUseAnalysisclearUse) 
 #endif
-  {
+  clearUseOfElementUnlocked(sgNode, initName);
+}
+
+void DefUseAnalysis::clearUseOfElementUnlocked(SgNode* sgNode, 
+                                    SgInitializedName* initName) {
+  indexValid = false;
   //  usetable[sgNode].erase(initName);
 
     multitype& map = usetable[sgNode];
     map.erase(std::remove_if(map.begin(), map.end(), boost::bind(boost::type<bool>(), DefUseAnalysismycond, _1, initName)), map.end());
-
-  }
 }
 
 /**********************************************************
@@ -160,7 +186,19 @@ void DefUseAnalysis::mapUseUnion(SgNode* before, SgNode* other, SgNode* sgNode)
  *  Union of two maps
  *********************************************************/
 void DefUseAnalysis::mapAnyUnion(tabletype* tabl, SgNode* before, SgNode* other, SgNode* sgNode) {
-  
+  if (isShard) {
+    mapAnyUnionUnlocked(tabl, before, other, sgNode);
+    return;
+  }
+#if ROSE_GCC_OMP
+#pragma omp critical (DefUseAnalysismapUse)
+#endif
+  mapAnyUnionUnlocked(tabl, before, other, sgNode);
+}
+
+void DefUseAnalysis::mapAnyUnionUnlocked(tabletype* tabl, SgNode* before, SgNode* other, SgNode* sgNode) {
+  indexValid = false;
+
   bool beforeFound = true;
   if ((*tabl).find(before)==(*tabl).end())
     beforeFound = false;
@@ -170,9 +208,6 @@ void DefUseAnalysis::mapAnyUnion(tabletype* tabl, SgNode* before, SgNode* other,
 
   addID(sgNode);
 
-#if ROSE_GCC_OMP
-#pragma omp critical (DefUseAnalysismapUse)
-#endif
   if (!beforeFound) {
     if (!otherFound)
       (*tabl)[sgNode].clear();
@@ -358,8 +393,10 @@ bool DefUseAnalysis::searchMap(const tabletype* ltable, SgNode* node) {
  * for any given node and initName, return all definitions 
  *****************************************/
 std::vector < SgNode* > DefUseAnalysis::getDefFor(SgNode* node, SgInitializedName* initName) {
-  multitype multi = getDefMultiMapFor(node);
-  return getAnyFor( &multi, initName); 
+  const multitype* multi = getDefsAt(node);
+  if (multi==NULL)
+    return vector<SgNode*>();
+  return getAnyFor(multi, initName); 
 }
 
 /******************************************
@@ -367,8 +404,10 @@ std::vector < SgNode* > DefUseAnalysis::getDefFor(SgNode* node, SgInitializedNam
  * for any given node and initName, return all definitions 
  *****************************************/
 std::vector < SgNode* > DefUseAnalysis::getUseFor(SgNode* node, SgInitializedName* initName) {
-  multitype multi = getUseMultiMapFor(node);
-  return getAnyFor(&multi, initName); 
+  const multitype* multi = getUsesAt(node);
+  if (multi==NULL)
+    return vector<SgNode*>();
+  return getAnyFor(multi, initName); 
 }
 
 /******************************************
@@ -398,12 +437,10 @@ std::vector < SgNode* > DefUseAnalysis::getAnyFor(const multitype* multi, SgInit
  * for any given node, return all definitions 
  *****************************************/
 std::vector <std::pair < SgInitializedName* , SgNode*> > DefUseAnalysis::getDefMultiMapFor(SgNode* node) {
-  multitype multi;
-  if (searchMap(&table, node)==true) {
-    // multimap is contained
-    multi = table[node];
-  }
-  return multi;
+  const multitype* multi = getDefsAt(node);
+  if (multi==NULL)
+    return multitype();
+  return *multi;
 }
 
 /******************************************
@@ -411,12 +448,59 @@ std::vector <std::pair < SgInitializedName* , SgNode*> > DefUseAnalysis::getDefM
  * for any given node, return all definitions 
  *****************************************/
 std::vector <std::pair < SgInitializedName* , SgNode*> > DefUseAnalysis::getUseMultiMapFor(SgNode* node) {
-  multitype multi;
-  if (searchMap(&usetable, node)==true) {
-    // multimap is contained
-    multi = usetable[node];
+  const multitype* multi = getUsesAt(node);
+  if (multi==NULL)
+    return multitype();
+  return *multi;
+}
+
+/******************************************
+ * return the definitions at a node without copying them
+ * NULL if the node is not in the table
+ *****************************************/
+const DefUseAnalysis::multitype* DefUseAnalysis::getDefsAt(SgNode* node) const {
+  return lookup(&table, &defIndex, node);
+}
+
+/******************************************
+ * return the usages at a node without copying them
+ * NULL if the node is not in the table
+ *****************************************/
+const DefUseAnalysis::multitype* DefUseAnalysis::getUsesAt(SgNode* node) const {
+  return lookup(&usetable, &useIndex, node);
+}
+
+/******************************************
+ * hash lookup if the index is up to date,
+ * otherwise fall back to the map
+ *****************************************/
+const DefUseAnalysis::multitype* DefUseAnalysis::lookup(const tabletype* tabl, const indextype* index, SgNode* node) const {
+  if (indexValid) {
+    indextype::const_iterator i = index->find(node);
+    if (i==index->end())
+      return NULL;
+    return i->second;
   }
-  return multi;
+  tabletype::const_iterator i = tabl->find(node);
+  if (i==tabl->end())
+    return NULL;
+  return &(i->second);
+}
+
+/******************************************
+ * index all entries of the def and use table
+ * the index points into the tables, nothing is copied
+ *****************************************/
+void DefUseAnalysis::buildIndex() {
+  defIndex.clear();
+  useIndex.clear();
+  defIndex.rehash(table.size());
+  useIndex.rehash(usetable.size());
+  for (tabletype::const_iterator i = table.begin(); i != table.end(); ++i)
+    defIndex[i->first] = &(i->second);
+  for (tabletype::const_iterator i = usetable.begin(); i != usetable.end(); ++i)
+    useIndex[i->first] = &(i->second);
+  indexValid = true;
 }
 
 /******************************************
@@ -490,6 +574,150 @@ bool  DefUseAnalysis::start_traversal_of_functions() {
   return abortme;  
 }
 
+/******************************************
+ * Move the results of one function into this analysis.
+ * Entries are swapped, not copied. A node can only
+ * be in several shards if it is a global variable
+ * (or a variable whose address is passed to a call);
+ * in that case the entries are merged.
+ *****************************************/
+void DefUseAnalysis::mergeShard(DefUseAnalysis* shard) {
+  tabletype* shardTables[] = { &shard->table, &shard->usetable };
+  tabletype* tables[] = { &table, &usetable };
+  for (int t = 0; t < 2; ++t) {
+    tabletype& target = *tables[t];
+    for (tabletype::iterator i = shardTables[t]->begin(); i != shardTables[t]->end(); ++i) {
+      std::pair<tabletype::iterator, bool> inserted = target.insert(make_pair(i->first, multitype()));
+      multitype& entry = inserted.first->second;
+      if (inserted.second) {
+        entry.swap(i->second);
+      } else {
+        std::set<std::pair<SgInitializedName*, SgNode*> > present(entry.begin(), entry.end());
+        for (multitype::const_iterator j = i->second.begin(); j != i->second.end(); ++j)
+          if (present.insert(*j).second)
+            entry.push_back(*j);
+      }
+    }
+  }
+  for (convtype::const_iterator i = shard->vizzhelp.begin(); i != shard->vizzhelp.end(); ++i)
+    vizzhelp.insert(*i);
+  indexValid = false;
+}
+
+/******************************************
+ * Does a shard define a global variable, i.e. does
+ * any of its entries hold a definition of a global
+ * variable that is not one of the initial ones?
+ *****************************************/
+static bool definesGlobalVariable(const DefUseAnalysis::tabletype& shardTable,
+                                  const std::set<std::pair<SgInitializedName*, SgNode*> >& initialGlobalDefs,
+                                  const std::set<SgInitializedName*>& globals) {
+  for (DefUseAnalysis::tabletype::const_iterator i = shardTable.begin(); i != shardTable.end(); ++i)
+    for (DefUseAnalysis::multitype::const_iterator j = i->second.begin(); j != i->second.end(); ++j)
+      if (globals.find(j->first)!=globals.end() && initialGlobalDefs.find(*j)==initialGlobalDefs.end())
+        return true;
+  return false;
+}
+
+/******************************************
+ * Parallel traversal over all functions
+ * Each function is analyzed into its own shard that
+ * starts from the global variable definitions only,
+ * so the threads never share a table. The shards are
+ * merged in function order afterwards. If any function
+ * defines a global variable, the serial traversal is
+ * used instead (see below).
+ *****************************************/
+bool  DefUseAnalysis::start_parallel_traversal_of_functions() {
+  if (DEBUG_MODE) 
+    cout << "START: Parallel Traversal over Functions" << endl;
+
+  nrOfNodesVisited = 0;
+  dfaFunctions.clear();
+  functionsAnalyzedInParallel = false;
+
+  // The serial traversal merges the entries of the global variables into
+  // the entry of every function, so the definitions of a global variable
+  // made by one function reach all the functions analyzed after it. The
+  // shards cannot see them: as soon as a shard defines a global variable,
+  // the remaining functions are skipped and the serial traversal is used.
+  std::set<SgInitializedName*> globals(globalVarList.begin(), globalVarList.end());
+  std::set<std::pair<SgInitializedName*, SgNode*> > initialGlobalDefs;
+  for (tabletype::const_iterator i = table.begin(); i != table.end(); ++i)
+    for (multitype::const_iterator j = i->second.begin(); j != i->second.end(); ++j)
+      if (globals.find(j->first)!=globals.end())
+        initialGlobalDefs.insert(*j);
+
+  Rose_STL_Container<SgNode*> functions = NodeQuery::querySubTree(project, V_SgFunctionDefinition); 
+  int nrOfFunctions = functions.size();
+  std::vector<DefUseAnalysis*> shards(nrOfFunctions, (DefUseAnalysis*)NULL);
+  std::vector<FilteredCFGNode <IsDFAFilter> > sources(nrOfFunctions, FilteredCFGNode<IsDFAFilter>(CFGNode(NULL, 0)));
+  std::vector<int> aborted(nrOfFunctions, 0);
+  int visited = 0;
+  bool globalDefined = false;
+
+#if ROSE_GCC_OMP
+#pragma omp parallel for schedule(dynamic) reduction(+:visited)
+#endif
+  for (int i = 0; i < nrOfFunctions; ++i) {
+    bool skip;
+#if ROSE_GCC_OMP
+#pragma omp critical (DefUseAnalysisGlobalDefined)
+#endif
+    skip = globalDefined;
+    if (skip)
+      continue;
+
+    SgFunctionDefinition* proc = isSgFunctionDefinition(functions[i]);
+    DefUseAnalysis* shard = new DefUseAnalysis(project);
+    shard->isShard = true;
+    shard->visualizationEnabled = false;
+    shard->globalVarList = globalVarList;
+    shard->table = table;
+    shard->usetable = usetable;
+
+    DefUseAnalysisPF defuse_perfunc(false, shard);
+    bool abortme=false;
+    sources[i] = defuse_perfunc.run(proc,abortme);
+    visited += defuse_perfunc.getNumberOfNodesVisited();
+    aborted[i] = abortme;
+    shards[i] = shard;
+
+    if (definesGlobalVariable(shard->table, initialGlobalDefs, globals)) {
+#if ROSE_GCC_OMP
+#pragma omp critical (DefUseAnalysisGlobalDefined)
+#endif
+      globalDefined = true;
+    }
+  }
+
+  if (globalDefined) {
+    if (DEBUG_MODE) 
+      cout << "A global variable is defined in a function, falling back to the serial traversal" << endl;
+    for (int i = 0; i < nrOfFunctions; ++i)
+      delete shards[i];
+    return start_traversal_of_functions();
+  }
+
+  bool abortme=false;
+  for (int i = 0; i < nrOfFunctions; ++i) {
+    mergeShard(shards[i]);
+    delete shards[i];
+    if (sources[i].getNode()!=NULL)
+      dfaFunctions.push_back(sources[i]);
+    if (aborted[i])
+      abortme=true;
+  }
+  nrOfNodesVisited = visited;
+  functionsAnalyzedInParallel = true;
+
+  if (DEBUG_MODE) {
+    dfaToDOT();
+    cout << "FINISH: Parallel Traversal over Functions" << endl;
+  }
+  return abortme;  
+}
+
 /******************************************
  * Traversal over one function
  *****************************************/
@@ -534,11 +762,16 @@ int DefUseAnalysis::run() {
 
   table.clear();
   vizzhelp.clear();
+  indexValid = false;
 
   clock_t start = clock();
   find_all_global_variables();
   // traverse through all functions and for each function doWorklist
-  aborted=start_traversal_of_functions();
+  if (parallelFunctions)
+    aborted=start_parallel_traversal_of_functions();
+  else
+    aborted=start_traversal_of_functions();
+  buildIndex();
   clock_t ends = clock();
   if (DEBUG_MODE)
   {
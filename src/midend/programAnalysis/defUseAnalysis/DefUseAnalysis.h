@@ -65,11 +65,17 @@ class ROSE_DLL_API DefUseAnalysis : public DFAnalysis, Support {
 
   bool visualizationEnabled;
 
+ public:
   // def-use-specific --------------------
   typedef std::vector < std::pair<SgInitializedName* , SgNode*> > multitype;
   //  typedef std::multimap < SgInitializedName* , SgNode* > multitype;
 
   typedef std::map< SgNode* , multitype > tabletype;
+
+ private:
+  // O(1) lookup of a node's entry in table/usetable. Rebuilt at the end of run(),
+  // and invalidated by anything that modifies the tables.
+  typedef rose_hash::unordered_map< SgNode* , const multitype* > indextype;
   // typedef std::map< SgNode* , int > convtype;
 // CH (4/9/2010): Use boost::unordered instead  
 //#ifdef _MSC_VER
@@ -100,14 +106,34 @@ class ROSE_DLL_API DefUseAnalysis : public DFAnalysis, Support {
   // functions to be printed in DFAtoDOT
   std::vector <FilteredCFGNode < IsDFAFilter > > dfaFunctions;
 
+  // parallel mode: each function is analyzed into its own shard, which
+  // is not shared between threads and therefore needs no locking
+  bool parallelFunctions;
+  bool isShard;
+  bool functionsAnalyzedInParallel;
+
+  indextype defIndex;
+  indextype useIndex;
+  bool indexValid;
+
   void addAnyElement(tabletype* tabl, SgNode* sgNode, SgInitializedName* initName, SgNode* defNode);
+  void addAnyElementUnlocked(tabletype* tabl, SgNode* sgNode, SgInitializedName* initName, SgNode* defNode);
+  void replaceElementUnlocked(SgNode* sgNode, SgInitializedName* initName);
+  void clearUseOfElementUnlocked(SgNode* sgNode, SgInitializedName* initName);
   void mapAnyUnion(tabletype* tabl, SgNode* before, SgNode* other, SgNode* current);
+  void mapAnyUnionUnlocked(tabletype* tabl, SgNode* before, SgNode* other, SgNode* current);
   void printAnyMap(tabletype* tabl);
 
+  bool start_parallel_traversal_of_functions();
+  void mergeShard(DefUseAnalysis* shard);
+  void buildIndex();
+  const multitype* lookup(const tabletype* tabl, const indextype* index, SgNode* node) const;
+
 
  public:
   DefUseAnalysis(SgProject* proj): project(proj), 
-    DEBUG_MODE(false), DEBUG_MODE_EXTRA(false){
+    DEBUG_MODE(false), DEBUG_MODE_EXTRA(false),
+    parallelFunctions(false), isShard(false), functionsAnalyzedInParallel(false), indexValid(false){
     //visualizationEnabled=true;
     //table.clear();
     //usetable.clear();
@@ -123,6 +149,30 @@ class ROSE_DLL_API DefUseAnalysis : public DFAnalysis, Support {
           std::map< SgNode* , multitype > use) {
     table = def;
     usetable = use;
+    indexValid = false;
+  }
+
+  // read-only access to the tables, without copying them
+  const tabletype& getDefTable() const { return table;}
+  const tabletype& getUseTable() const { return usetable;}
+
+  // the definitions/usages at a node, or NULL if the node has no entry.
+  // O(1) after run(); the pointer is valid until the tables are modified.
+  const multitype* getDefsAt(SgNode* node) const;
+  const multitype* getUsesAt(SgNode* node) const;
+
+  // analyze the functions concurrently (requires ROSE_GCC_OMP, otherwise
+  // run() stays serial). Every function starts from the global variable
+  // definitions only. The serial traversal propagates the definitions of a
+  // global variable from one function to all the functions after it, so if
+  // any function defines a global variable run() falls back to the serial
+  // traversal; the tables are then always identical to serial mode.
+  void enableParallelFunctionAnalysis() {
+    parallelFunctions=true;
+  }
+  // did the last run() analyze the functions separately, without falling back?
+  bool usedParallelFunctionAnalysis() const {
+    return functionsAnalyzedInParallel;
   }
        
   // def-use-public-functions -----------
@@ -163,6 +213,9 @@ class ROSE_DLL_API DefUseAnalysis : public DFAnalysis, Support {
   void flush() {
    table.clear();
    usetable.clear();
+   defIndex.clear();
+   useIndex.clear();
+   indexValid=false;
    globalVarList.clear();
    vizzhelp.clear();
    sgNodeCounter=1;
@@ -181,6 +234,9 @@ class ROSE_DLL_API DefUseAnalysis : public DFAnalysis, Support {
   void flushDefuse() {
    table.clear();
    usetable.clear();
+   defIndex.clear();
+   useIndex.clear();
+   indexValid=false;
    //   vizzhelp.clear();
    //sgNodeCounter=1;
   }
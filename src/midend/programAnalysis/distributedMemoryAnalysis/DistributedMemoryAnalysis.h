@@ -5,12 +5,13 @@
 #ifndef DISTRIBUTED_MEMORY_ANALYSIS_H
 #define DISTRIBUTED_MEMORY_ANALYSIS_H
 
+#include <utility>
+#include <vector>
+
 #if ROSE_MPI
 
 //#include <mpi.h>
 
-#include <utility>
-
 void initializeDistributedMemoryProcessing(int *argc, char ***argv);
 void finalizeDistributedMemoryProcessing();
 
@@ -59,11 +60,21 @@ template <class InheritedAttributeType, class SynthesizedAttributeType>
 class DistributedMemoryTraversal: public DistributedMemoryAnalysisBase<InheritedAttributeType>
 {
 public:
+    /* StaticScheduling splits the functions into contiguous ranges of about equal node count before the analysis
+     * starts. DynamicScheduling makes the root process a master that hands out chunks of functions, heaviest
+     * first, to the other processes as soon as they are done with their previous chunk. */
+    enum SchedulingPolicy { StaticScheduling, DynamicScheduling };
+
     void performAnalysis(SgNode *root, InheritedAttributeType rootInheritedValue,
                          AstTopDownProcessing<InheritedAttributeType> *preTraversal,
                          AstBottomUpProcessing<SynthesizedAttributeType> *postTraversal);
     SynthesizedAttributeType getFinalResults() {return finalResults;}
-    DistributedMemoryTraversal() {}
+    void setScheduling(SchedulingPolicy policy, size_t minimumChunkSize = 1)
+    {
+        scheduling = policy;
+        this->minimumChunkSize = minimumChunkSize;
+    }
+    DistributedMemoryTraversal(): scheduling(StaticScheduling), minimumChunkSize(1) {}
     virtual ~DistributedMemoryTraversal() {}
 
 protected:
@@ -76,11 +87,72 @@ protected:
 private:
     SynthesizedAttributeType finalResults;
     std::vector<SynthesizedAttributeType> functionResults;
+    SchedulingPolicy scheduling;
+    size_t minimumChunkSize;
+
+    void performDynamicAnalysis(SgNode *root, InheritedAttributeType rootInheritedValue,
+                                AstTopDownProcessing<InheritedAttributeType> *preTraversal,
+                                AstBottomUpProcessing<SynthesizedAttributeType> *postTraversal);
 
     DistributedMemoryTraversal(const DistributedMemoryTraversal &);
     const DistributedMemoryTraversal &operator=(const DistributedMemoryTraversal &);
 };
 
+#endif
+
+
+
+
+template <class InheritedAttributeType>
+class DistributedMemoryAnalysisScheduler;
+
+/* ProcessPoolTraversal: the same interface as DistributedMemoryTraversal, but the functions are analyzed by a pool of
+ * worker processes forked from the current process on the local machine, so MPI is not needed. The workers inherit
+ * the AST through fork(); the chunks of functions they are assigned and the serialized results they compute are sent
+ * through pipes. performAnalysis() only returns in the calling process, which holds the final results. With a single
+ * process (or a single function) the analysis runs in the calling process without forking. */
+template <class InheritedAttributeType, class SynthesizedAttributeType>
+class ProcessPoolTraversal
+{
+public:
+    void performAnalysis(SgNode *root, InheritedAttributeType rootInheritedValue,
+                         AstTopDownProcessing<InheritedAttributeType> *preTraversal,
+                         AstBottomUpProcessing<SynthesizedAttributeType> *postTraversal);
+    SynthesizedAttributeType getFinalResults() {return finalResults;}
+    void setMinimumChunkSize(size_t size) {minimumChunkSize = size;}
+
+    // In analyzeSubtree(), myID() is the number of the worker process (0 .. numberOfProcesses()-1).
+    bool isRootProcess() const {return !worker;}
+    int myID() const { return my_rank; }
+    int numberOfProcesses() const { return processes; }
+
+    // The default number of worker processes is the number of online processors.
+    ProcessPoolTraversal(int processes = 0);
+    virtual ~ProcessPoolTraversal() {}
+
+protected:
+    virtual SynthesizedAttributeType analyzeSubtree(SgFunctionDeclaration *funcDecl,
+                                                    InheritedAttributeType initialInheritedValue) = 0;
+    virtual std::pair<int, void *> serializeAttribute(SynthesizedAttributeType attribute) const = 0;
+    virtual SynthesizedAttributeType deserializeAttribute(std::pair<int, void *> serializedAttribute) const = 0;
+    virtual void deleteSerializedAttribute(std::pair<int, void *> serializedAttribute) const {}
+
+private:
+    SynthesizedAttributeType finalResults;
+    std::vector<SynthesizedAttributeType> functionResults;
+    size_t minimumChunkSize;
+    bool worker;
+    int my_rank;
+    int processes;
+
+    void runWorker(int readFd, int writeFd, DistributedMemoryAnalysisScheduler<InheritedAttributeType> &scheduler);
+    static bool writeAll(int fd, const void *buffer, size_t size);
+    static bool readAll(int fd, void *buffer, size_t size);
+
+    ProcessPoolTraversal(const ProcessPoolTraversal &);
+    const ProcessPoolTraversal &operator=(const ProcessPoolTraversal &);
+};
+
 
 
 
@@ -163,6 +235,39 @@ private:
 
 
 
+/* Shared by the dynamic schedulers: runs the pre traversal, keeps the functions in traversal order (the order in which
+ * the post traversal expects their results) and hands out chunks of them, heaviest first. Each chunk is a range of
+ * positions in the schedule; get_function() maps a position back to the function's index in traversal order. */
+template <class InheritedAttributeType>
+class DistributedMemoryAnalysisScheduler
+{
+public:
+    DistributedMemoryAnalysisScheduler(SgNode *root, InheritedAttributeType rootInheritedValue,
+                                       AstTopDownProcessing<InheritedAttributeType> *preTraversal,
+                                       size_t minimumChunkSize);
+
+    std::vector<SgFunctionDeclaration *> &get_funcDecls() {return funcDecls;}
+    std::vector<InheritedAttributeType> &get_initialInheritedValues() {return initialInheritedValues;}
+    size_t get_function(size_t position) const {return schedule[position];}
+    size_t get_totalNodes() const {return totalNodes;}
+
+    // Returns false once all functions have been handed out.
+    bool nextChunk(int workers, std::pair<size_t, size_t> &chunk);
+
+private:
+    std::vector<SgFunctionDeclaration *> funcDecls;
+    std::vector<InheritedAttributeType> initialInheritedValues;
+    std::vector<size_t> schedule;
+    std::vector<double> weights;
+    double remainingWeight;
+    size_t totalNodes;
+    size_t next;
+    size_t minimumChunkSize;
+};
+
+
+
+
 
 
 
@@ -174,5 +279,3 @@ private:
 #include "DistributedMemoryAnalysisImplementation.h"
 
 #endif
-
-#endif
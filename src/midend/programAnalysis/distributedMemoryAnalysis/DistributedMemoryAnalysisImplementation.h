@@ -18,12 +18,49 @@
 
 //#include <mpi.h>
 #include <math.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
 
 #define DIS_DEBUG_OUTPUT false
 #define RUN_STD true
 #define RUN_DECLARATION false
 #define ALLGATHER_MPI false
 
+// --------------------------------------------------------------------------
+// utilization reporting for the dynamic schedulers
+// --------------------------------------------------------------------------
+
+inline double
+distributedMemoryAnalysisTime()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + 1e-6 * tv.tv_usec;
+}
+
+/* Prints, for each process, how many functions it analyzed and which fraction of the wall clock time of the analysis
+ * phase it spent in analyzeSubtree() and serializeAttribute(). */
+inline void
+distributedMemoryAnalysisReportUtilization(const std::vector<int> &functions, const std::vector<double> &busy,
+                                           double wallTime)
+{
+    for (size_t rank = 0; rank < functions.size(); rank++)
+    {
+        std::cerr << " Processor : " << rank << "  analyzed " << functions[rank] << " functions. Busy "
+                  << busy[rank] << " of " << wallTime << " sec ("
+                  << (wallTime > 0 ? 100.0 * busy[rank] / wallTime : 0.0) << "%)" << std::endl;
+    }
+}
+
+#if ROSE_MPI
+
 // --------------------------------------------------------------------------
 // class DistributedMemoryAnalysisBase -- version by Gergo (based on nodes weight)
 // --------------------------------------------------------------------------
@@ -148,6 +185,8 @@ computeFunctionIndices(
     return std::make_pair(my_lo, my_hi);
 }
 
+#endif
+
 //compare function for std sort
 struct SortDescending : public std::binary_function<std::pair<double, size_t>,std::pair<double, size_t>,bool> 
 {
@@ -157,6 +196,8 @@ struct SortDescending : public std::binary_function<std::pair<double, size_t>,st
   }
 };
 
+#if ROSE_MPI
+
 template <class InheritedAttributeType>
 void
 DistributedMemoryAnalysisBase<InheritedAttributeType>::
@@ -318,6 +359,12 @@ performAnalysis(SgNode *root, InheritedAttributeType rootInheritedValue,
 #if DIS_DEBUG_OUTPUT
       std::cout << " >>> >>>>>>>>>>>>> start computeFunctionIndeces" << std::endl;
 #endif
+    if (scheduling == DynamicScheduling)
+    {
+        performDynamicAnalysis(root, rootInheritedValue, preTraversal, postTraversal);
+        return;
+    }
+
     /* see what functions to run our analysis on */
     std::pair<int, int> my_limits = computeFunctionIndices(root, rootInheritedValue, preTraversal);
 #if DIS_DEBUG_OUTPUT
@@ -511,6 +558,202 @@ performAnalysis(SgNode *root, InheritedAttributeType rootInheritedValue,
 
 
 
+template <class InheritedAttributeType, class SynthesizedAttributeType>
+void
+DistributedMemoryTraversal<InheritedAttributeType, SynthesizedAttributeType>::
+performDynamicAnalysis(SgNode *root, InheritedAttributeType rootInheritedValue,
+                       AstTopDownProcessing<InheritedAttributeType> *preTraversal,
+                       AstBottomUpProcessing<SynthesizedAttributeType> *postTraversal)
+{
+    const int work_request_tag = 1;
+    const int work_assignment_tag = 2;
+    const int root_process = DistributedMemoryAnalysisBase<InheritedAttributeType>::root_process;
+    const int processes = DistributedMemoryAnalysisBase<InheritedAttributeType>::numberOfProcesses();
+    const int my_rank = DistributedMemoryAnalysisBase<InheritedAttributeType>::myID();
+
+    /* every process runs the pre traversal; it is deterministic, so all processes agree on the schedule and the
+     * master only needs to send ranges of schedule positions */
+    DistributedMemoryAnalysisScheduler<InheritedAttributeType> scheduler(root, rootInheritedValue, preTraversal,
+                                                                        minimumChunkSize);
+    std::vector<SgFunctionDeclaration *> &funcDecls = scheduler.get_funcDecls();
+    std::vector<InheritedAttributeType> &initialInheritedValues = scheduler.get_initialInheritedValues();
+    DistributedMemoryAnalysisBase<InheritedAttributeType>::funcDecls = funcDecls;
+    DistributedMemoryAnalysisBase<InheritedAttributeType>::initialInheritedValues = initialInheritedValues;
+    size_t functions = funcDecls.size();
+
+    if (my_rank == root_process)
+    {
+        DistributedMemoryAnalysisBase<InheritedAttributeType>::nrOfNodes = scheduler.get_totalNodes();
+        std::cout << "ROOT - scheduling functions dynamically: " << functions << ", total nodes: "
+                  << scheduler.get_totalNodes() << std::endl;
+    }
+
+    double startTime = MPI_Wtime();
+    double busyTime = 0;
+    std::vector<int> myIndices;
+    std::vector<std::pair<int, void *> > serializedResults;
+
+    if (processes > 1 && my_rank == root_process)
+    {
+        /* the root is the master: it answers work requests until every worker has been sent an empty chunk */
+        int activeWorkers = processes - 1;
+        while (activeWorkers > 0)
+        {
+            MPI_Status status;
+            MPI_Recv(NULL, 0, MPI_INT, MPI_ANY_SOURCE, work_request_tag, MPI_COMM_WORLD, &status);
+            std::pair<size_t, size_t> chunk(0, 0);
+            if (!scheduler.nextChunk(processes - 1, chunk))
+                activeWorkers--;
+            int assignment[2] = {(int) chunk.first, (int) chunk.second};
+            MPI_Send(assignment, 2, MPI_INT, status.MPI_SOURCE, work_assignment_tag, MPI_COMM_WORLD);
+        }
+    }
+    else
+    {
+        /* ask for chunks of functions until there are none left; with a single process there is nobody to ask */
+        for (;;)
+        {
+            std::pair<size_t, size_t> chunk(0, 0);
+            if (processes == 1)
+            {
+                if (!scheduler.nextChunk(1, chunk))
+                    break;
+            }
+            else
+            {
+                int assignment[2];
+                MPI_Send(NULL, 0, MPI_INT, root_process, work_request_tag, MPI_COMM_WORLD);
+                MPI_Recv(assignment, 2, MPI_INT, root_process, work_assignment_tag, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                if (assignment[0] == assignment[1])
+                    break;
+                chunk = std::make_pair((size_t) assignment[0], (size_t) assignment[1]);
+            }
+
+            double chunkStart = MPI_Wtime();
+            for (size_t k = chunk.first; k < chunk.second; k++)
+            {
+                size_t i = scheduler.get_function(k);
+                SynthesizedAttributeType result = analyzeSubtree(funcDecls[i], initialInheritedValues[i]);
+                serializedResults.push_back(serializeAttribute(result));
+                myIndices.push_back(i);
+            }
+            busyTime += MPI_Wtime() - chunkStart;
+        }
+    }
+    double wallTime = MPI_Wtime() - startTime;
+
+    /* concatenate the serialized attributes into a single buffer */
+    int myCount = myIndices.size();
+    int *myFunctionIndices = new int[myCount];
+    int *myStateSizes = new int[myCount];
+    int myTotalSize = 0;
+    for (int i = 0; i < myCount; i++)
+    {
+        myFunctionIndices[i] = myIndices[i];
+        myStateSizes[i] = serializedResults[i].first;
+        myTotalSize += myStateSizes[i];
+    }
+    unsigned char *myBuffer = new unsigned char[myTotalSize];
+    int sizeSoFar = 0;
+    for (int i = 0; i < myCount; i++)
+    {
+        std::memcpy(myBuffer + sizeSoFar, serializedResults[i].second, serializedResults[i].first);
+        sizeSoFar += serializedResults[i].first;
+        deleteSerializedAttribute(serializedResults[i]);
+    }
+
+    /* communicate results: unlike in the static case, the root does not know in advance how many (and which)
+     * functions each process analyzed, so the counts and function indices are gathered along with the sizes */
+    int *counts = NULL;
+    int *displacements = NULL;
+    double *busy = NULL;
+    int *functionIndices = NULL;
+    int *stateSizes = NULL;
+    int *totalStateSizes = NULL;
+    int *byteDisplacements = NULL;
+    unsigned char *recvbuf = NULL;
+    if (my_rank == root_process)
+    {
+        counts = new int[processes];
+        displacements = new int[processes];
+        busy = new double[processes];
+        functionIndices = new int[functions];
+        stateSizes = new int[functions];
+        totalStateSizes = new int[processes];
+        byteDisplacements = new int[processes];
+    }
+    MPI_Gather(&myCount, 1, MPI_INT, counts, 1, MPI_INT, root_process, MPI_COMM_WORLD);
+    MPI_Gather(&busyTime, 1, MPI_DOUBLE, busy, 1, MPI_DOUBLE, root_process, MPI_COMM_WORLD);
+    if (my_rank == root_process)
+    {
+        displacements[0] = 0;
+        for (int i = 1; i < processes; i++)
+            displacements[i] = displacements[i-1] + counts[i-1];
+        ROSE_ASSERT(displacements[processes-1] + counts[processes-1] == (int) functions);
+    }
+    MPI_Gatherv(myFunctionIndices, myCount, MPI_INT, functionIndices, counts, displacements, MPI_INT,
+                root_process, MPI_COMM_WORLD);
+    MPI_Gatherv(myStateSizes, myCount, MPI_INT, stateSizes, counts, displacements, MPI_INT,
+                root_process, MPI_COMM_WORLD);
+    if (my_rank == root_process)
+    {
+        int totalSize = 0;
+        int j = 0;
+        for (int i = 0; i < processes; i++)
+        {
+            byteDisplacements[i] = totalSize;
+            totalStateSizes[i] = 0;
+            int j_lim = j + counts[i];
+            while (j < j_lim)
+                totalStateSizes[i] += stateSizes[j++];
+            totalSize += totalStateSizes[i];
+        }
+        recvbuf = new unsigned char[totalSize];
+    }
+    MPI_Gatherv(myBuffer, myTotalSize, MPI_UNSIGNED_CHAR,
+                recvbuf, totalStateSizes, byteDisplacements, MPI_UNSIGNED_CHAR,
+                root_process, MPI_COMM_WORLD);
+
+    if (my_rank == root_process)
+    {
+        std::vector<int> functionsPerRank(counts, counts + processes);
+        std::vector<double> busyPerRank(busy, busy + processes);
+        distributedMemoryAnalysisReportUtilization(functionsPerRank, busyPerRank, wallTime);
+
+        /* unpack the serialized states into the slots of their functions in traversal order, which is the order
+         * the post traversal consumes them in */
+        functionResults.assign(functions, SynthesizedAttributeType());
+        int offset = 0;
+        for (size_t j = 0; j < functions; j++)
+        {
+            std::pair<int, void *> serializedAttribute = std::make_pair(stateSizes[j], recvbuf + offset);
+            functionResults[functionIndices[j]] = deserializeAttribute(serializedAttribute);
+            offset += stateSizes[j];
+        }
+
+        /* perform the post traversal */
+        DistributedMemoryAnalysisPostTraversal<SynthesizedAttributeType> postT(postTraversal, functionResults);
+        finalResults = postT.traverse(root, false);
+
+        /* clean up */
+        delete[] counts;
+        delete[] displacements;
+        delete[] busy;
+        delete[] functionIndices;
+        delete[] stateSizes;
+        delete[] totalStateSizes;
+        delete[] byteDisplacements;
+        delete[] recvbuf;
+    }
+    delete[] myFunctionIndices;
+    delete[] myStateSizes;
+    delete[] myBuffer;
+}
+
+#endif
+
+
+
 
 
 // --------------------------------------------------------------------------
@@ -789,6 +1032,344 @@ evaluateSynthesizedAttribute(SgNode *node, bool inFunction,
     return postTraversal->evaluateSynthesizedAttribute(node, synAttrs);
 }
 
-#endif
 
 
+
+
+// --------------------------------------------------------------------------
+// class DistributedMemoryAnalysisScheduler
+// --------------------------------------------------------------------------
+
+template <class InheritedAttributeType>
+DistributedMemoryAnalysisScheduler<InheritedAttributeType>::
+DistributedMemoryAnalysisScheduler(SgNode *root, InheritedAttributeType rootInheritedValue,
+                                   AstTopDownProcessing<InheritedAttributeType> *preTraversal,
+                                   size_t minimumChunkSize)
+  : remainingWeight(0), totalNodes(0), next(0), minimumChunkSize(minimumChunkSize > 0 ? minimumChunkSize : 1)
+{
+    DistributedMemoryAnalysisPreTraversal<InheritedAttributeType> nodeCounter(preTraversal);
+    nodeCounter.traverse(root, rootInheritedValue);
+
+    funcDecls = nodeCounter.get_funcDecls();
+    initialInheritedValues = nodeCounter.get_initialInheritedValues();
+    std::vector<size_t> &nodeCounts = nodeCounter.get_nodeCounts();
+    std::vector<size_t> &funcWeights = nodeCounter.get_funcWeights();
+    ROSE_ASSERT(funcDecls.size() == initialInheritedValues.size());
+    ROSE_ASSERT(funcDecls.size() == nodeCounts.size());
+    ROSE_ASSERT(funcDecls.size() == funcWeights.size());
+
+    /* the same weights as in sortFunctions(), but only the schedule is sorted; the functions themselves stay in
+     * traversal order */
+    std::vector<std::pair<double, size_t> > order(funcDecls.size());
+    for (size_t i = 0; i < funcDecls.size(); i++)
+    {
+        order[i].first = (double) nodeCounts[i] * funcWeights[i];
+        order[i].second = i;
+        totalNodes += nodeCounts[i];
+    }
+    std::stable_sort(order.begin(), order.end(), SortDescending());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        schedule.push_back(order[i].second);
+        weights.push_back(order[i].first);
+        remainingWeight += order[i].first;
+    }
+}
+
+template <class InheritedAttributeType>
+bool
+DistributedMemoryAnalysisScheduler<InheritedAttributeType>::
+nextChunk(int workers, std::pair<size_t, size_t> &chunk)
+{
+    if (next >= schedule.size())
+        return false;
+
+    /* guided self-scheduling by weight: a chunk gets about half of an even share of the remaining work, so the heavy
+     * functions at the front of the schedule are handed out one at a time while the light ones at the end are
+     * batched to save round trips */
+    double target = remainingWeight / (2.0 * (workers > 0 ? workers : 1));
+    size_t end = next;
+    double chunkWeight = 0;
+    while (end < schedule.size() && (end - next < minimumChunkSize || chunkWeight + weights[end] <= target))
+        chunkWeight += weights[end++];
+
+    chunk = std::make_pair(next, end);
+    remainingWeight -= chunkWeight;
+    next = end;
+    return true;
+}
+
+
+
+
+// --------------------------------------------------------------------------
+// class ProcessPoolTraversal
+// --------------------------------------------------------------------------
+
+template <class InheritedAttributeType, class SynthesizedAttributeType>
+ProcessPoolTraversal<InheritedAttributeType, SynthesizedAttributeType>::
+ProcessPoolTraversal(int processes)
+  : minimumChunkSize(1), worker(false), my_rank(0), processes(processes)
+{
+    if (this->processes <= 0)
+    {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        this->processes = (online > 0 ? (int) online : 1);
+    }
+}
+
+template <class InheritedAttributeType, class SynthesizedAttributeType>
+bool
+ProcessPoolTraversal<InheritedAttributeType, SynthesizedAttributeType>::
+writeAll(int fd, const void *buffer, size_t size)
+{
+    const char *p = (const char *) buffer;
+    while (size > 0)
+    {
+        ssize_t n = write(fd, p, size);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+template <class InheritedAttributeType, class SynthesizedAttributeType>
+bool
+ProcessPoolTraversal<InheritedAttributeType, SynthesizedAttributeType>::
+readAll(int fd, void *buffer, size_t size)
+{
+    char *p = (char *) buffer;
+    while (size > 0)
+    {
+        ssize_t n = read(fd, p, size);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+template <class InheritedAttributeType, class SynthesizedAttributeType>
+void
+ProcessPoolTraversal<InheritedAttributeType, SynthesizedAttributeType>::
+runWorker(int readFd, int writeFd, DistributedMemoryAnalysisScheduler<InheritedAttributeType> &scheduler)
+{
+    std::vector<SgFunctionDeclaration *> &funcDecls = scheduler.get_funcDecls();
+    std::vector<InheritedAttributeType> &initialInheritedValues = scheduler.get_initialInheritedValues();
+
+    /* analyze the chunks of schedule positions sent by the master until it sends an empty one; the results of a
+     * chunk are sent back as a single message of (function index, size, serialized attribute) records */
+    for (;;)
+    {
+        size_t assignment[2];
+        if (!readAll(readFd, assignment, sizeof assignment) || assignment[0] == assignment[1])
+            break;
+
+        double chunkStart = distributedMemoryAnalysisTime();
+        std::vector<unsigned char> records;
+        for (size_t k = assignment[0]; k < assignment[1]; k++)
+        {
+            size_t i = scheduler.get_function(k);
+            SynthesizedAttributeType result = analyzeSubtree(funcDecls[i], initialInheritedValues[i]);
+            std::pair<int, void *> serializedAttribute = serializeAttribute(result);
+            records.insert(records.end(), (unsigned char *) &i, (unsigned char *) &i + sizeof i);
+            records.insert(records.end(), (unsigned char *) &serializedAttribute.first,
+                           (unsigned char *) &serializedAttribute.first + sizeof serializedAttribute.first);
+            records.insert(records.end(), (unsigned char *) serializedAttribute.second,
+                           (unsigned char *) serializedAttribute.second + serializedAttribute.first);
+            deleteSerializedAttribute(serializedAttribute);
+        }
+        double busyTime = distributedMemoryAnalysisTime() - chunkStart;
+
+        size_t header[2] = {assignment[1] - assignment[0], records.size()};
+        if (!writeAll(writeFd, header, sizeof header) || !writeAll(writeFd, &busyTime, sizeof busyTime)
+            || (!records.empty() && !writeAll(writeFd, &records[0], records.size())))
+            break;
+    }
+    close(readFd);
+    close(writeFd);
+}
+
+template <class InheritedAttributeType, class SynthesizedAttributeType>
+void
+ProcessPoolTraversal<InheritedAttributeType, SynthesizedAttributeType>::
+performAnalysis(SgNode *root, InheritedAttributeType rootInheritedValue,
+                AstTopDownProcessing<InheritedAttributeType> *preTraversal,
+                AstBottomUpProcessing<SynthesizedAttributeType> *postTraversal)
+{
+    DistributedMemoryAnalysisScheduler<InheritedAttributeType> scheduler(root, rootInheritedValue, preTraversal,
+                                                                        minimumChunkSize);
+    std::vector<SgFunctionDeclaration *> &funcDecls = scheduler.get_funcDecls();
+    std::vector<InheritedAttributeType> &initialInheritedValues = scheduler.get_initialInheritedValues();
+    size_t functions = funcDecls.size();
+    functionResults.assign(functions, SynthesizedAttributeType());
+
+    int workers = processes;
+    if ((size_t) workers > functions)
+        workers = functions;
+    if (workers < 1)
+        workers = 1;
+    std::vector<int> functionsPerWorker(workers, 0);
+    std::vector<double> busy(workers, 0);
+    double startTime = distributedMemoryAnalysisTime();
+
+    if (workers == 1)
+    {
+        /* not worth forking, analyze all functions in this process */
+        for (size_t i = 0; i < functions; i++)
+            functionResults[i] = analyzeSubtree(funcDecls[i], initialInheritedValues[i]);
+        functionsPerWorker[0] = functions;
+        busy[0] = distributedMemoryAnalysisTime() - startTime;
+    }
+    else
+    {
+        /* flush buffered output, otherwise every worker would print it again */
+        std::cout.flush();
+        std::cerr.flush();
+        fflush(NULL);
+
+        std::vector<pid_t> pids(workers);
+        std::vector<int> toWorker(workers), fromWorker(workers);
+        for (int w = 0; w < workers; w++)
+        {
+            int down[2], up[2];
+            if (pipe(down) != 0 || pipe(up) != 0)
+            {
+                std::cerr << "ProcessPoolTraversal: pipe() failed: " << strerror(errno) << std::endl;
+                ROSE_ASSERT(false);
+            }
+            pid_t pid = fork();
+            if (pid < 0)
+            {
+                std::cerr << "ProcessPoolTraversal: fork() failed: " << strerror(errno) << std::endl;
+                ROSE_ASSERT(false);
+            }
+            if (pid == 0)
+            {
+                /* worker: drop the pipe ends of the master and of the workers forked before this one */
+                close(down[1]);
+                close(up[0]);
+                for (int v = 0; v < w; v++)
+                {
+                    close(toWorker[v]);
+                    close(fromWorker[v]);
+                }
+                worker = true;
+                my_rank = w;
+                runWorker(down[0], up[1], scheduler);
+                std::cout.flush();
+                std::cerr.flush();
+                fflush(NULL);
+                _exit(0);
+            }
+            close(down[0]);
+            close(up[1]);
+            pids[w] = pid;
+            toWorker[w] = down[1];
+            fromWorker[w] = up[0];
+        }
+
+        /* master: a worker that is idle gets the next chunk of the schedule, or an empty chunk that tells it to exit
+         * when the schedule is exhausted; then wait for any busy worker to send back its results */
+        std::vector<struct pollfd> fds(workers);
+        std::vector<bool> idle(workers, true);
+        for (int w = 0; w < workers; w++)
+        {
+            fds[w].fd = fromWorker[w];
+            fds[w].events = POLLIN;
+        }
+        int activeWorkers = workers;
+        while (activeWorkers > 0)
+        {
+            for (int w = 0; w < workers; w++)
+            {
+                if (!idle[w] || fds[w].fd < 0)
+                    continue;
+                std::pair<size_t, size_t> chunk(0, 0);
+                scheduler.nextChunk(workers, chunk);
+                size_t assignment[2] = {chunk.first, chunk.second};
+                if (!writeAll(toWorker[w], assignment, sizeof assignment))
+                {
+                    std::cerr << "ProcessPoolTraversal: cannot send work to process " << w << std::endl;
+                    ROSE_ASSERT(false);
+                }
+                idle[w] = false;
+                if (chunk.first == chunk.second)
+                {
+                    fds[w].fd = -1;
+                    activeWorkers--;
+                }
+            }
+            if (activeWorkers == 0)
+                break;
+
+            if (poll(&fds[0], workers, -1) < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                std::cerr << "ProcessPoolTraversal: poll() failed: " << strerror(errno) << std::endl;
+                ROSE_ASSERT(false);
+            }
+            for (int w = 0; w < workers; w++)
+            {
+                if (fds[w].fd < 0 || (fds[w].revents & (POLLIN | POLLHUP | POLLERR)) == 0)
+                    continue;
+
+                size_t header[2];
+                double busyTime;
+                if (!readAll(fds[w].fd, header, sizeof header) || !readAll(fds[w].fd, &busyTime, sizeof busyTime))
+                {
+                    std::cerr << "ProcessPoolTraversal: process " << w << " died" << std::endl;
+                    ROSE_ASSERT(false);
+                }
+                std::vector<unsigned char> records(header[1]);
+                if (!records.empty() && !readAll(fds[w].fd, &records[0], records.size()))
+                {
+                    std::cerr << "ProcessPoolTraversal: process " << w << " died" << std::endl;
+                    ROSE_ASSERT(false);
+                }
+
+                /* unpack the results into the slots of their functions in traversal order */
+                size_t offset = 0;
+                for (size_t r = 0; r < header[0]; r++)
+                {
+                    size_t i;
+                    int size;
+                    std::memcpy(&i, &records[offset], sizeof i);
+                    offset += sizeof i;
+                    std::memcpy(&size, &records[offset], sizeof size);
+                    offset += sizeof size;
+                    ROSE_ASSERT(i < functions && offset + size <= records.size());
+                    functionResults[i] = deserializeAttribute(std::make_pair(size, (void *) (&records[0] + offset)));
+                    offset += size;
+                }
+                functionsPerWorker[w] += header[0];
+                busy[w] += busyTime;
+                idle[w] = true;
+            }
+        }
+
+        for (int w = 0; w < workers; w++)
+        {
+            int status = 0;
+            close(toWorker[w]);
+            close(fromWorker[w]);
+            if (waitpid(pids[w], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+                std::cerr << "ProcessPoolTraversal: process " << w << " did not exit cleanly" << std::endl;
+        }
+    }
+    distributedMemoryAnalysisReportUtilization(functionsPerWorker, busy, distributedMemoryAnalysisTime() - startTime);
+
+    /* perform the post traversal */
+    DistributedMemoryAnalysisPostTraversal<SynthesizedAttributeType> postT(postTraversal, functionResults);
+    finalResults = postT.traverse(root, false);
+}
+
+#endif
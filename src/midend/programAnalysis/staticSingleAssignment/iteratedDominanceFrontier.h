@@ -52,6 +52,40 @@ namespace ssa_private
         return result;
     }
 
+    /** Variant of calculateIteratedDominanceFrontier for CFG nodes numbered 0 to n-1. The dominance frontier of each node
+     * is a list of node ids, and the worklist is processed in the same order as the map-based version, so both
+     * place phi functions at the same nodes. */
+    inline vector<int> calculateIteratedDominanceFrontier(const vector<vector<int> >& dominanceFrontiers,
+    const vector<int>& startNodes)
+    {
+        vector<int> result;
+        vector<bool> inResult(dominanceFrontiers.size(), false);
+        vector<bool> visitedNodes(dominanceFrontiers.size(), false);
+        vector<int> worklist(startNodes.begin(), startNodes.end());
+
+        while (!worklist.empty())
+        {
+            int currentNode = worklist.back();
+            worklist.pop_back();
+            visitedNodes[currentNode] = true;
+
+            BOOST_FOREACH(int dfNode, dominanceFrontiers[currentNode])
+            {
+                if (visitedNodes[dfNode])
+                    continue;
+
+                if (!inResult[dfNode])
+                {
+                    inResult[dfNode] = true;
+                    result.push_back(dfNode);
+                }
+                worklist.push_back(dfNode);
+            }
+        }
+
+        return result;
+    }
+
     /** Calculates the dominance frontier for each node in the control flow graph of the given function.
      * @param iDominatorMap map from each node to its immediate dominator
      * @param iPostDominatorMap map from each node to its immediate postdominator */
@@ -15,6 +15,7 @@
 #include <boost/foreach.hpp>
 #include <filteredCFG.h>
 #include <boost/unordered_map.hpp>
+#include <boost/dynamic_bitset.hpp>
 #include "reachingDef.h"
 #include "dataflowCfgFilter.h"
 #include "CallGraph.h"
@@ -106,9 +107,32 @@ private:
     LocalDefUseTable expandedDefTable;
 
     /** Maps each node to the reaching definitions at that node.
-     * The table is populated with phi functions using iterated dominance frontiers, and then
-     * is filled through dataflow. */
-    GlobalReachingDefTable reachingDefsTable;
+     * The entry of a node is built from denseReachingDefs the first time the node is queried. */
+    mutable GlobalReachingDefTable reachingDefsTable;
+
+    /** The definitions of one analyzed function, indexed by the definition ids used by the dataflow. */
+    struct FunctionDefinitions
+    {
+        std::vector<ReachingDefPtr> defs;
+
+        /** The id of the variable defined by each definition. */
+        std::vector<int> defVars;
+
+        std::vector<VarName> varNames;
+    };
+
+    /** The definitions reaching a node (IN) and flowing out of it (OUT), as bit vectors over the definition ids
+     * of its function. */
+    struct NodeReachingDefSets
+    {
+        boost::shared_ptr<const FunctionDefinitions> function;
+        boost::dynamic_bitset<> in;
+        boost::dynamic_bitset<> out;
+    };
+
+    /** The result of the dataflow for every CFG node of the analyzed functions that has not been queried yet.
+     * Converting all of them to the map-based reachingDefsTable would take much more memory. */
+    mutable boost::unordered_map<SgNode*, NodeReachingDefSets> denseReachingDefs;
 
     /** This is the table that is populated with all the use information for all the variables
      * at all the nodes. It is populated during the runDefUse function, and is done
@@ -153,9 +177,13 @@ public:
     }
 
 private:
-    /** Once all the local definitions have been inserted in the ssaLocalDefsTable and phi functions have been inserted
-     * in the reaching defs table, propagate reaching definitions along the CFG. */
-    void runDefUseDataFlow(SgFunctionDefinition* func);
+    /** Dense numbering of the CFG nodes, variables and definitions of one function, together with the
+     * bit vectors used to propagate reaching definitions. Defined in staticSingleAssignmentCalculation.C. */
+    struct FunctionDataflowState;
+
+    /** Once all the local definitions have been numbered and phi functions have been inserted,
+     * propagate reaching definitions along the CFG and fill in the reaching defs table. */
+    void runDefUseDataFlow(SgFunctionDefinition* func, FunctionDataflowState& state);
 
     /** Returns true if the variable is implicitly defined at the function entry by the compiler. */
     static bool isBuiltinVar(const VarName& var);
@@ -203,34 +231,42 @@ private:
     void insertDefsForExternalVariables(SgFunctionDeclaration* function);
 
     /** Find where phi functions need to be inserted and insert empty phi functions at those nodes.
-     * This updates the IN part of the reaching def table with Phi functions.
-     * 
-     * @param cfgNodesInPostOrder all the CFG nodes of the function
+     * The phi functions are recorded in the dataflow state; they reach the IN part of the reaching def table
+     * once the dataflow has run.
+     *
+     * @param state numbering of the CFG nodes of the function. Variables defined in the function are numbered here.
      * @returns the control dependencies. */
     std::multimap< FilteredCfgNode, std::pair<FilteredCfgNode, FilteredCfgEdge> > insertPhiFunctions(SgFunctionDefinition* function,
-            const std::vector<FilteredCfgNode>& cfgNodesInPostOrder);
+            FunctionDataflowState& state);
 
     /** Create ReachingDef objects for each local def and insert them in the local def table. */
     void populateLocalDefsTable(SgFunctionDeclaration* function);
 
-    /** Give numbers to all the reachingDef objects. Should be called after phi functions are inserted
-     * and the local def table is populated, but before dataflow propagates the definitions. 
-     * 
-     * @param cfgNodesInPostOrder a list of all the CFG nodes in the function, in postorder. */
-    void renumberAllDefinitions(SgFunctionDefinition* func, const std::vector<FilteredCfgNode>& cfgNodesInPostOrder);
+    /** Give a definition id to every ReachingDef object in the local def table that belongs to a CFG node
+     * of the function. Should be called after phi functions are inserted. */
+    void numberLocalDefinitions(FunctionDataflowState& state);
 
-    /** Take all the outgoing defs from previous nodes and merge them as the incoming defs
-     * of the current node. */
-    void updateIncomingPropagatedDefs(FilteredCfgNode cfgNode);
+    /** Give numbers to all the reachingDef objects. Should be called after phi functions are inserted
+     * and the local definitions are numbered, but before dataflow propagates the definitions. */
+    void renumberAllDefinitions(FunctionDataflowState& state);
 
-    /** Performs the data-flow update for one individual node, populating the reachingDefsTable for that node.
+    /** Performs the data-flow update for one individual node, updating the OUT set of that node.
+     * @param scratch storage for the new OUT set; it is swapped with the node's OUT set when that changes.
      * @returns true if the OUT defs from the node changed, false if they stayed the same. */
-    bool propagateDefs(FilteredCfgNode cfgNode);
+    bool propagateDefs(int nodeId, FunctionDataflowState& state, boost::dynamic_bitset<>& scratch);
+
+    /** Once the dataflow has converged, records the IN and OUT definitions of every CFG node in denseReachingDefs
+     * and links each phi function to the definitions it joins. */
+    void populateReachingDefsTable(FunctionDataflowState& state);
+
+    /** Returns the IN and OUT tables of the node, building them from denseReachingDefs if the node has not been
+     * queried before. Returns NULL if the node is not a CFG node of an analyzed function. */
+    const std::pair<NodeReachingDefTable, NodeReachingDefTable>* getReachingDefTables(SgNode* node) const;
 
     /** Once all the reaching def information has been propagated, uses the reaching def information and the local
      * use information to match uses to their reaching defs. 
-     * @param cfgNodesInPostOrder all the nodes for which uses should be matched to defs*/
-    void buildUseTable(const std::vector<FilteredCfgNode>& cfgNodes);
+     * @param state the dataflow state of the function whose uses should be matched to defs */
+    void buildUseTable(FunctionDataflowState& state);
 
     /** Iterates all the CFG nodes in the function and returns them in postorder, according to depth-first search.
      * Reverse postorder is the most efficient order for dataflow propagation. */
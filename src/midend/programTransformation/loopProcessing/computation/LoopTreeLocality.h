@@ -3,6 +3,8 @@
 #define LOOP_TREE_LOCALITY
 
 #include <LoopTreeDepComp.h>
+#include <map>
+#include <vector>
 
 struct DepCompAstRef { 
   AstNodePtr orig; 
@@ -91,6 +93,15 @@ class LoopTreeLocalityAnal
   LoopTreeDepComp& GetDepComp() { return comp; }
 
   float SelfSpatialReuses( LoopTreeNode *n, int loop, int linesize);
+  // number of cache lines newly touched by statement 'n' at each iteration 
+  // of its surrounding loop at level 'loop'
+  float SelfCacheMisses( LoopTreeNode *n, int loop, int linesize);
+  // accumulates into 'footprint' (indexed by array name) the number of bytes 
+  // of each array accessed by statement 'n' when each of the loops at 'levels' 
+  // is restricted to 'tilesize' iterations
+  void TileFootprint( LoopTreeNode *n, const std::vector<int>& levels, 
+                      unsigned tilesize, int linesize, 
+                      std::map<std::string,float>& footprint);
   int TemporaryReuseRefs(LoopTreeNode *s1, int loop1, LoopTreeNode *s2, int loop2,
                    AstNodeSet &refSet, int reuseDist);
 };
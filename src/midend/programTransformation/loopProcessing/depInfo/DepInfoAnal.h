@@ -14,6 +14,25 @@
 extern bool DebugDep();
 
 class DependenceTesting;
+
+// Results of array dependence tests keyed by a normalized signature of the
+// problem (subscript coefficients, loop bounds and domains), so that access
+// patterns repeated across references and loop nests are solved only once.
+class DepTestCache
+{
+ public:
+  DepTestCache() : lookups(0), hits(0) {}
+  bool Lookup( const std::string& signature, DepInfo& result);
+  void Insert( const std::string& signature, const DepInfo& result)
+     { cache[signature] = result; }
+  unsigned NumOfLookups() const { return lookups; }
+  unsigned NumOfHits() const { return hits; }
+  std::string toString() const;
+ private:
+  std::map<std::string, DepInfo, std::less<std::string> > cache;
+  unsigned lookups, hits;
+};
+
 class DepInfoAnal 
 {
  public:
@@ -46,6 +65,7 @@ class DepInfoAnal
 
   DepInfoAnal(AstInterface& fa, DependenceTesting& h);
   DepInfoAnal(AstInterface& fa);
+  ~DepInfoAnal();
 
   const ModifyVariableInfo& GetModifyVariableInfo() const { return varmodInfo;}
   StmtRefDep GetStmtRefDep( const AstNodePtr& s1, const AstNodePtr& r1,
@@ -71,11 +91,13 @@ class DepInfoAnal
                       int deptype = DEPTYPE_DATA);
 
   AstInterface& get_astInterface() { return varmodInfo.get_astInterface(); }
+  DepTestCache& GetArrayDepCache() { return arrayDepCache; }
 
  private:
         DependenceTesting& handle;
         std::map <AstNodePtr, LoopDepInfo, std::less <AstNodePtr> > stmtInfo;
         ModifyVariableInfo varmodInfo;
+        DepTestCache arrayDepCache;
 };
 
 class DependenceTesting{
@@ -40,6 +40,8 @@ class DepTestStatistics
                 double _omega_t0;
                 std::string _filename;
                 unsigned int _dep_test_choice;
+                int _num_cache_lookups;
+                int _num_cache_hits;
 
         public:
                 DepTestStatistics() : _total_problems(0),
@@ -67,7 +69,9 @@ class DepTestStatistics
                                       _total_time_adhoc(0),
                                       _total_time_plato(0),
                                       _total_time_omega(0),
-                                      _dep_test_choice(0) {};
+                                      _dep_test_choice(0),
+                                      _num_cache_lookups(0),
+                                      _num_cache_hits(0) {};
 
 
                 int AddProblem(int p);
@@ -99,6 +103,8 @@ class DepTestStatistics
                 double SetOmegaTime(void);
                 double GetTime(void);
                 void SetDepChoice(unsigned int dep_test_choice);
+                void AddCacheLookup(bool hit);
+                double GetCacheHitRate(void);
                 void PrintResults(void);
 };
 
@@ -24,6 +24,13 @@ float SelfSpatialReuse( const AstNodePtr& r,
                         const std::string& ivarname, unsigned linesize, 
                         unsigned  defaultArrayBound = 100);
 
+// returns the number of new cache lines touched by the array access 'r' at each 
+// increase of the induction variable 'ivarname', assuming cache line size is 
+// 'linesize'; returns 0 if 'r' is not array access or is invariant of 'ivarname'
+float CacheLineAccesses( const AstNodePtr& r, 
+                        const std::string& ivarname, unsigned linesize, 
+                        unsigned  defaultArrayBound = 100);
+
 // input: ep: a list of DepInfos between references; 
 //        loopmap: the loop to be placed innermost for each reference; 
 //        dist: the maximum reuse distance between the innermost loops of two references
@@ -83,6 +83,18 @@ class AllLoopReuseBlocking : public LoopBlocking
                         const CompSliceDepGraphNode::FullNestInfo& nestInfo);
 };
 
+/* block all loops carrying reuse with a single block size chosen so that
+   the data accessed within a block fits in half of the cache (see -bk_cache)*/
+class CacheModelBlocking : public LoopBlocking
+{
+ public:
+  virtual LoopTransformOptions::OptType GetOptimizationType() { return LoopTransformOptions::LOOP_NEST_OPT; }
+  /* return the innermost slice after blocking */
+  virtual const CompSlice* 
+  SetBlocking( CompSliceLocalityRegistry *anal, 
+                        const CompSliceDepGraphNode::FullNestInfo& nestInfo);
+};
+
 class ParameterizeBlocking : public AllLoopReuseBlocking
 {
  protected:
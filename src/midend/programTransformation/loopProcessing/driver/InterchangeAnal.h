@@ -37,4 +37,12 @@ class ArrangeReuseOrder : public ArrangeNestingOrder
    virtual LoopTransformOptions::OptType GetOptimizationType() { return LoopTransformOptions::PAR_LOOP_OPT; }
 };
 
+class ArrangeCacheCostOrder : public ArrangeNestingOrder
+{
+  protected:
+    virtual void SetNestingWeight(CompSliceLocalityRegistry *anal, CompSliceNest& g, float *weightvec);
+  public:
+   virtual LoopTransformOptions::OptType GetOptimizationType() { return LoopTransformOptions::LOOP_NEST_OPT; }
+};
+
 #endif
@@ -39,7 +39,7 @@ class LoopTransformOptions
   LoopBlocking *bkOp;
   LoopPar * parOp;
   CopyArrayOperator* cpOp;
-  unsigned cacheline, reuseDist, splitlimit, defaultblocksize, parblocksize;
+  unsigned cacheline, reuseDist, splitlimit, defaultblocksize, parblocksize, cachesize;
   LoopTransformOptions();
   ~LoopTransformOptions();
 
@@ -55,6 +55,7 @@ class LoopTransformOptions
   ArrangeNestingOrder* GetInterchangeSel() const  { return icOp; }
   LoopNestFusion* GetFusionSel() const { return fsOp; }
   unsigned GetCacheLineSize() const { return cacheline; }
+  unsigned GetCacheSize() const { return cachesize; }
   unsigned GetReuseDistance() const { return reuseDist; }
   unsigned GetTransAnalSplitLimit() const { return splitlimit; }
   unsigned GetDefaultBlockSize() const { return defaultblocksize; }
@@ -76,6 +77,7 @@ class LoopTransformOptions
   void SetInterchangeSel( ArrangeNestingOrder* sel);
   void SetFusionSel( LoopNestFusion* sel);
   void SetCacheLineSize( unsigned sel) { cacheline = sel; }
+  void SetCacheSize( unsigned sel) { cachesize = sel; }
   void SetReuseDistance( unsigned sel) { reuseDist = sel; }
   void SetTransAnalSplitLimit( unsigned sel) { splitlimit = sel; }
 };
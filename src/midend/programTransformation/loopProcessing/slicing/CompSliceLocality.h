@@ -18,6 +18,8 @@ class CompSliceLocalityAnal
   int SpatialReuses(const CompSlice *slice1, const CompSlice *slice2,
                       AstNodeSet& refSet);
   float SpatialReuses( const CompSlice *slice1);
+  float CacheMisses( const CompSlice *slice);
+  float TileFootprint( const CompSliceNest& nest, int first, unsigned tilesize);
   unsigned GetCacheLineSize() const { return linesize; }
 };
 
@@ -57,15 +59,21 @@ class CompSliceLocalityRegistry : protected CompSliceLocalityAnal
   class SliceSelfInfo
   {
    float spatialReuses;
+   float cacheMisses; // negative until computed (only -ic2 needs it)
    CompSliceLocalityAnal::AstNodeSet tmpRefSet;
   public:
    SliceSelfInfo (CompSliceLocalityAnal& anal, const CompSlice *slice)
+     : cacheMisses(-1)
    { 
      spatialReuses = anal.SpatialReuses(slice);
      anal.TemporaryReuses(slice, slice, tmpRefSet);
    }
    void FuseSelfInfo( const SliceSelfInfo& that, const SliceRelInfo& rel)
    { spatialReuses += that.spatialReuses;
+     if (cacheMisses >= 0 && that.cacheMisses >= 0)
+        cacheMisses += that.cacheMisses;
+     else
+        cacheMisses = -1;
      const CompSliceLocalityAnal::AstNodeSet* 
                  tmpSet1 = rel.get_temporaryReuseSet();
      tmpRefSet.insert( that.tmpRefSet.begin(), that.tmpRefSet.end());
@@ -78,6 +86,12 @@ class CompSliceLocalityRegistry : protected CompSliceLocalityAnal
             return tmpRefSet.size();
          }
    float SpatialReuses() { return spatialReuses; }
+   float CacheMisses(CompSliceLocalityAnal& anal, const CompSlice *slice) 
+     { 
+       if (cacheMisses < 0)
+          cacheMisses = anal.CacheMisses(slice);
+       return cacheMisses;
+     }
    std::string toString() const
     {  
        std::stringstream out;
@@ -99,6 +113,11 @@ class CompSliceLocalityRegistry : protected CompSliceLocalityAnal
   int SpatialReuses(const CompSlice *slice1, const CompSlice *slice2);
   int TemporaryReuses(const CompSlice* slice);
   float SpatialReuses( const CompSlice *slice);
+  float CacheMisses( const CompSlice *slice);
+  float TileFootprint( const CompSliceNest& nest, int first, unsigned tilesize)
+      { return CompSliceLocalityAnal::TileFootprint(nest, first, tilesize); }
+  unsigned GetCacheLineSize() const 
+      { return CompSliceLocalityAnal::GetCacheLineSize(); }
 };
 
 #endif
@@ -194,6 +194,15 @@ extern bool XOMP_master(void);
 extern void XOMP_atomic_start (void);
 extern void XOMP_atomic_end (void);
 
+// Lock-free *x op= value, used for "omp atomic" and +, - and * reductions on float and double variables
+// (x -= value is x += -value; integer variables are updated with GCC's __sync builtins directly)
+extern void XOMP_atomic_add_float (float* x, double value);
+extern void XOMP_atomic_mul_float (float* x, double value);
+extern void XOMP_atomic_div_float (float* x, double value);
+extern void XOMP_atomic_add_double (double* x, double value);
+extern void XOMP_atomic_mul_double (double* x, double value);
+extern void XOMP_atomic_div_double (double* x, double value);
+
 // Specific method for Nanos++ executing OpenMP atomic
 // op: integer defining the operation performed inside the atomic
 // type: type of the variables used in the atomic operation
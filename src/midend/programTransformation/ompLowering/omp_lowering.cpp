@@ -3273,14 +3273,147 @@ std::map <SgVariableSymbol *, bool> collectVariableAppearance (SgNode* root)
 #endif      // USE_ROSE_NANOS_OPENMP_LIBRARY
 }
 
+#ifndef USE_ROSE_NANOS_OPENMP_LIBRARY
+  //! Check if a type can be updated by GCC's __sync_fetch_and_op() builtins: integer scalars of 1, 2, 4, or 8 bytes
+  static bool isNativeAtomicIntegerType(SgType* t)
+  {
+    ROSE_ASSERT (t != NULL);
+    t = t->stripTypedefsAndModifiers();
+    return (isSgTypeChar(t) || isSgTypeUnsignedChar(t) || isSgTypeSignedChar(t) || isSgTypeWchar(t) ||
+            isSgTypeShort(t) || isSgTypeUnsignedShort(t) || isSgTypeSignedShort(t) ||
+            isSgTypeInt(t) || isSgTypeUnsignedInt(t) || isSgTypeSignedInt(t) ||
+            isSgTypeLong(t) || isSgTypeUnsignedLong(t) || isSgTypeSignedLong(t) ||
+            isSgTypeLongLong(t) || isSgTypeUnsignedLongLong(t) || isSgTypeSignedLongLong(t));
+  }
+
+  //! Build the body of a compare-and-swap loop doing 'var op= value' on an integer scalar:
+  //    {
+  //      T* p_atomic_addr_ = &var;
+  //      V p_atomic_value_ = value;
+  //      T p_atomic_old_;
+  //      do
+  //        p_atomic_old_ = *p_atomic_addr_;
+  //      while (!__sync_bool_compare_and_swap(p_atomic_addr_, p_atomic_old_, (T)(p_atomic_old_ op p_atomic_value_)));
+  //    }
+  // var and value are evaluated once. Return NULL for an operation which is not a binary operator of "omp atomic".
+  static SgBasicBlock* buildCompareAndSwapLoop(SgExpression* var, SgExpression* value, VariantT op, SgScopeStatement* scope)
+  {
+    SgBasicBlock* bb = buildBasicBlock();
+    SgType* var_type = var->get_type()->stripTypedefsAndModifiers();
+    SgType* pointee_type = isSgReferenceType(var->get_type()) ? isSgReferenceType(var->get_type())->get_base_type() : var->get_type();
+    SgVariableDeclaration* addr_decl = buildVariableDeclaration("p_atomic_addr_", buildPointerType(pointee_type),
+                                         buildAssignInitializer(buildAddressOfOp(copyExpression(var))), bb);
+    appendStatement(addr_decl, bb);
+    SgVariableDeclaration* value_decl = buildVariableDeclaration("p_atomic_value_", value->get_type(),
+                                          buildAssignInitializer(copyExpression(value)), bb);
+    appendStatement(value_decl, bb);
+    SgVariableDeclaration* old_decl = buildVariableDeclaration("p_atomic_old_", var_type, NULL, bb);
+    appendStatement(old_decl, bb);
+
+    SgExpression* new_exp = NULL;
+    switch (op)
+    {
+      case V_SgPlusAssignOp: new_exp = buildAddOp(buildVarRefExp(old_decl), buildVarRefExp(value_decl)); break;
+      case V_SgMinusAssignOp: new_exp = buildSubtractOp(buildVarRefExp(old_decl), buildVarRefExp(value_decl)); break;
+      case V_SgMultAssignOp: new_exp = buildMultiplyOp(buildVarRefExp(old_decl), buildVarRefExp(value_decl)); break;
+      case V_SgDivAssignOp: new_exp = buildDivideOp(buildVarRefExp(old_decl), buildVarRefExp(value_decl)); break;
+      case V_SgAndAssignOp: new_exp = buildBitAndOp(buildVarRefExp(old_decl), buildVarRefExp(value_decl)); break;
+      case V_SgIorAssignOp: new_exp = buildBitOrOp(buildVarRefExp(old_decl), buildVarRefExp(value_decl)); break;
+      case V_SgXorAssignOp: new_exp = buildBitXorOp(buildVarRefExp(old_decl), buildVarRefExp(value_decl)); break;
+      case V_SgLshiftAssignOp: new_exp = buildLshiftOp(buildVarRefExp(old_decl), buildVarRefExp(value_decl)); break;
+      case V_SgRshiftAssignOp: new_exp = buildRshiftOp(buildVarRefExp(old_decl), buildVarRefExp(value_decl)); break;
+      default:
+        deepDelete(bb);
+        return NULL;
+    }
+
+    SgStatement* load_stmt = buildAssignStatement(buildVarRefExp(old_decl), buildPointerDerefExp(buildVarRefExp(addr_decl)));
+    SgExprListExp* parameters = buildExprListExp(buildVarRefExp(addr_decl), buildVarRefExp(old_decl),
+                                                 buildCastExp(new_exp, var_type));
+    SgExpression* cas_exp = buildFunctionCallExp("__sync_bool_compare_and_swap", buildBoolType(), parameters, scope);
+    appendStatement(buildDoWhileStmt(load_stmt, buildNotOp(cas_exp)), bb);
+    return bb;
+  }
+
+  //! Build a statement doing 'var op= value' with a native atomic operation instead of the runtime lock, e.g.
+  //    __sync_fetch_and_add(&shared, local);    // integer types, GCC builtins
+  //    { ... __sync_bool_compare_and_swap() loop ... }  // integer types, the other operators or a non-integer value
+  //    XOMP_atomic_mul_double(&shared, local);  // float and double, a compare-and-swap loop in XOMP
+  // op is one of V_SgPlusAssignOp, V_SgMinusAssignOp, V_SgMultAssignOp, V_SgDivAssignOp, V_SgAndAssignOp, 
+  // V_SgIorAssignOp, V_SgXorAssignOp, V_SgLshiftAssignOp and V_SgRshiftAssignOp. var and value are copied. 
+  // Whether NULL is returned (no native support, the caller uses the runtime lock) only depends on the type of var, 
+  // so that all atomic updates of a variable use the same mechanism: a lock does not exclude native updates.
+  static SgStatement* buildNativeAtomicUpdate(SgExpression* var, SgExpression* value, VariantT op, SgScopeStatement* scope)
+  {
+    ROSE_ASSERT (var != NULL && value != NULL && scope != NULL);
+    if (SageInterface::is_Fortran_language())
+      return NULL;
+
+    SgType* var_type = var->get_type()->stripTypedefsAndModifiers();
+    if (isNativeAtomicIntegerType(var_type))
+    {
+      // the __sync_fetch_and_op() builtins convert the value to the type of var before the operation, which is 
+      // only the same as converting the result for integer values; everything else is a compare-and-swap loop
+      string func_name;
+      if (isNativeAtomicIntegerType(value->get_type()))
+      {
+        switch (op)
+        {
+          case V_SgPlusAssignOp: func_name = "__sync_fetch_and_add"; break;
+          case V_SgMinusAssignOp: func_name = "__sync_fetch_and_sub"; break;
+          case V_SgAndAssignOp: func_name = "__sync_fetch_and_and"; break;
+          case V_SgIorAssignOp: func_name = "__sync_fetch_and_or"; break;
+          case V_SgXorAssignOp: func_name = "__sync_fetch_and_xor"; break;
+          default: break;
+        }
+      }
+      if (func_name.empty())
+      {
+        SgBasicBlock* cas_loop = buildCompareAndSwapLoop(var, value, op, scope);
+        ROSE_ASSERT (cas_loop != NULL);
+        return cas_loop;
+      }
+      SgExprListExp* parameters = buildExprListExp(buildAddressOfOp(copyExpression(var)), copyExpression(value));
+      return buildFunctionCallStmt(func_name, buildVoidType(), parameters, scope);
+    }
+#ifdef ENABLE_XOMP
+    else if (isSgTypeFloat(var_type) || isSgTypeDouble(var_type))
+    {
+      // the value is passed as a double, so float variables are updated as in 'x = (float)(x op (double)value)'.
+      // x -= value is x += -(double)value: negating first in the type of value would wrap around for unsigned values.
+      string func_name;
+      bool negate = false;
+      switch (op)
+      {
+        case V_SgPlusAssignOp: func_name = "XOMP_atomic_add_"; break;
+        case V_SgMinusAssignOp: func_name = "XOMP_atomic_add_"; negate = true; break;
+        case V_SgMultAssignOp: func_name = "XOMP_atomic_mul_"; break;
+        case V_SgDivAssignOp: func_name = "XOMP_atomic_div_"; break;
+        default: return NULL;  // the other operators are not valid for floating point types
+      }
+      func_name += isSgTypeFloat(var_type) ? "float" : "double";
+
+      SgExpression* value_exp = copyExpression(value);
+      if (negate)
+        value_exp = buildMinusOp(buildCastExp(value_exp, buildDoubleType()));
+      SgExprListExp* parameters = buildExprListExp(buildAddressOfOp(copyExpression(var)), value_exp);
+      return buildFunctionCallStmt(func_name, buildVoidType(), parameters, scope);
+    }
+#endif
+    return NULL;
+  }
+#endif
+
   // Two ways 
-  //1. builtin function TODO
-  //    __sync_fetch_and_add_4(&shared, (unsigned int)local);
+  //1. builtin function
+  //    __sync_fetch_and_add(&shared, local);
   //2. using atomic runtime call: 
   //    GOMP_atomic_start (); // void GOMP_atomic_start (void); 
   //    shared = shared op local;
   //    GOMP_atomic_end (); // void GOMP_atomic_end (void); 
-  // We use the 2nd method only for now, for simplicity and portability
+  // We use the 1st method, or a compare-and-swap loop, for x++, x--, and all x op= expr forms on integer scalars (and 
+  // on float and double with XOMP), see buildNativeAtomicUpdate(). The 2nd method is used for the other types only: the
+  // runtime lock does not exclude native updates, so all atomic updates of a variable must use the same method.
   void transOmpAtomic(SgNode* node)
   {
     ROSE_ASSERT(node != NULL );
@@ -3399,6 +3532,33 @@ std::map <SgVariableSymbol *, bool> collectVariableAppearance (SgNode* root)
     
 #else
 
+    SgExprStatement* atomic_stmt = isSgExprStatement(body);
+    SgStatement* native_stmt = NULL;
+    if (atomic_stmt != NULL)
+    {
+      SgExpression* atomic_expr = atomic_stmt->get_expression();
+      if (isSgPlusPlusOp(atomic_expr) || isSgMinusMinusOp(atomic_expr))
+      {
+        SgIntVal* one = buildIntVal(1);
+        native_stmt = buildNativeAtomicUpdate(isSgUnaryOp(atomic_expr)->get_operand(), one,
+                                              isSgPlusPlusOp(atomic_expr) ? V_SgPlusAssignOp : V_SgMinusAssignOp, scope);
+        delete one;
+      }
+      else if (isSgPlusAssignOp(atomic_expr) || isSgMinusAssignOp(atomic_expr) || isSgMultAssignOp(atomic_expr) ||
+               isSgDivAssignOp(atomic_expr) || isSgAndAssignOp(atomic_expr) || isSgIorAssignOp(atomic_expr) ||
+               isSgXorAssignOp(atomic_expr) || isSgLshiftAssignOp(atomic_expr) || isSgRshiftAssignOp(atomic_expr))
+      {
+        SgBinaryOp* binary_op = isSgBinaryOp(atomic_expr);
+        native_stmt = buildNativeAtomicUpdate(binary_op->get_lhs_operand_i(), binary_op->get_rhs_operand_i(),
+                                              atomic_expr->variantT(), scope);
+      }
+    }
+    if (native_stmt != NULL)
+    {
+      replaceStatement(body, native_stmt, true);
+      return;
+    }
+
 #ifdef ENABLE_XOMP
     SgExprStatement* func_call_stmt1 = buildFunctionCallStmt("XOMP_atomic_start", buildVoidType(), NULL, scope);
     SgExprStatement* func_call_stmt2 = buildFunctionCallStmt("XOMP_atomic_end", buildVoidType(), NULL, scope);
@@ -4243,16 +4403,54 @@ static void insertOmpLastprivateCopyBackStmts(SgStatement* ompStmt, vector <SgSt
   // orig_var: the reduction variable's original copy
   // local_decl: the local copy of the reduction variable
   // Two ways to do the reduction operation: 
-  //1. builtin function TODO
-  //    __sync_fetch_and_add_4(&shared, (unsigned int)local);
+  //1. builtin function
+  //    __sync_fetch_and_add(&shared, local);
   //2. using atomic runtime call: 
   //    GOMP_atomic_start ();
   //    shared = shared op local;
   //    GOMP_atomic_end ();
-  // We use the 2nd method only for now for simplicity and portability
+  // We use the 1st method (or a compare-and-swap loop, see buildNativeAtomicUpdate()) for +, -, *, &, |, and ^ on 
+  // integer scalars (and on float and double with XOMP), and the 2nd method for the other operators and types.
+  // Note that the partial results of a '-' reduction are added, as required by the OpenMP specification.
 #ifndef USE_ROSE_NANOS_OPENMP_LIBRARY
 static void insertOmpReductionCopyBackStmts (SgOmpClause::omp_reduction_operator_enum r_operator, vector <SgStatement* >& end_stmt_list,  SgBasicBlock* bb1, SgInitializedName* orig_var, SgVariableDeclaration* local_decl)
 {
+    VariantT native_op = V_SgNode;
+    switch (r_operator)
+    {
+        case SgOmpClause::e_omp_reduction_plus:
+        case SgOmpClause::e_omp_reduction_minus:
+            native_op = V_SgPlusAssignOp;
+            break;
+        case SgOmpClause::e_omp_reduction_mul:
+            native_op = V_SgMultAssignOp;
+            break;
+        case SgOmpClause::e_omp_reduction_bitand:
+            native_op = V_SgAndAssignOp;
+            break;
+        case SgOmpClause::e_omp_reduction_bitor:
+            native_op = V_SgIorAssignOp;
+            break;
+        case SgOmpClause::e_omp_reduction_bitxor:
+            native_op = V_SgXorAssignOp;
+            break;
+        default:
+            break;
+    }
+    if (native_op != V_SgNode)
+    {
+        SgVarRefExp* shared_ref = buildVarRefExp(orig_var, bb1);
+        SgVarRefExp* local_ref = buildVarRefExp(local_decl);
+        SgStatement* native_stmt = buildNativeAtomicUpdate(shared_ref, local_ref, native_op, bb1);
+        delete shared_ref;
+        delete local_ref;
+        if (native_stmt != NULL)
+        {
+            end_stmt_list.push_back(native_stmt);
+            return;
+        }
+    }
+
 #ifdef ENABLE_XOMP
     SgExprStatement* atomic_start_stmt = buildFunctionCallStmt("XOMP_atomic_start", buildVoidType(), NULL, bb1); 
 #else  
@@ -4269,7 +4467,7 @@ static void insertOmpReductionCopyBackStmts (SgOmpClause::omp_reduction_operator
             r_exp = buildMultiplyOp(buildVarRefExp(orig_var, bb1), buildVarRefExp(local_decl)); 
             break;
         case SgOmpClause::e_omp_reduction_minus:
-            r_exp = buildSubtractOp(buildVarRefExp(orig_var, bb1), buildVarRefExp(local_decl)); 
+            r_exp = buildAddOp(buildVarRefExp(orig_var, bb1), buildVarRefExp(local_decl)); 
             break;
         case SgOmpClause::e_omp_reduction_bitand:
             r_exp = buildBitAndOp(buildVarRefExp(orig_var, bb1), buildVarRefExp(local_decl)); 
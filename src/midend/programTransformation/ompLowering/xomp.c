@@ -1851,6 +1851,46 @@ void XOMP_atomic_end (void)
 #endif
 }
 
+//---------
+// Lock-free x op= value for float and double, generated for "omp atomic" and +, - and * reductions
+// instead of XOMP_atomic_start()/XOMP_atomic_end(), which serialize all atomic updates of a program.
+// A compare-and-swap loop on the bit pattern of the variable is used. The value is passed as a double,
+// so float variables are updated as in x = (float)(x op value), as C does for a double value.
+// All forms are lock-free: an update under the lock would not be atomic with respect to them.
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 1))
+#define XOMP_HAVE_SYNC_BUILTINS 1
+#endif
+
+#ifdef XOMP_HAVE_SYNC_BUILTINS
+#define XOMP_ATOMIC_FLOATING_POINT_UPDATE(func_name, type, int_type, op) \
+void func_name (type* x, double value) \
+{ \
+  union { type f; int_type i; } old_val, new_val; \
+  assert (sizeof(type) == sizeof(int_type)); \
+  do \
+  { \
+    old_val.f = *(volatile type*)x; \
+    new_val.f = (type)(old_val.f op value); \
+  } while (!__sync_bool_compare_and_swap((int_type*)x, old_val.i, new_val.i)); \
+}
+#else
+// Without the builtins, no other atomic update is lock-free either
+#define XOMP_ATOMIC_FLOATING_POINT_UPDATE(func_name, type, int_type, op) \
+void func_name (type* x, double value) \
+{ \
+  XOMP_atomic_start(); \
+  *x = (type)(*x op value); \
+  XOMP_atomic_end(); \
+}
+#endif
+
+XOMP_ATOMIC_FLOATING_POINT_UPDATE(XOMP_atomic_add_float, float, unsigned int, +)
+XOMP_ATOMIC_FLOATING_POINT_UPDATE(XOMP_atomic_mul_float, float, unsigned int, *)
+XOMP_ATOMIC_FLOATING_POINT_UPDATE(XOMP_atomic_div_float, float, unsigned int, /)
+XOMP_ATOMIC_FLOATING_POINT_UPDATE(XOMP_atomic_add_double, double, unsigned long long, +)
+XOMP_ATOMIC_FLOATING_POINT_UPDATE(XOMP_atomic_mul_double, double, unsigned long long, *)
+XOMP_ATOMIC_FLOATING_POINT_UPDATE(XOMP_atomic_div_double, double, unsigned long long, /)
+
 #else
 
 void XOMP_atomic_for_NANOS(int op, int type, void * variable, void * operand)
@@ -3,6 +3,7 @@
 
 #include "threadSupport.h"
 #include <list>
+#include <vector>
 
 /** User callbacks. See the ROSE_Callbacks::List class for details. */
 namespace ROSE_Callbacks {
@@ -74,42 +75,75 @@ namespace ROSE_Callbacks {
      *  @code
      *  bool result = cbl.apply(true, MyCallback::Args(insn, 5, "foo"));
      *  @endcode
-     */
+     *
+     *  @section ROSE_Callbacks_List_Snapshots Snapshots
+     *
+     *  Lists are usually modified only while a tool is being configured but applied for every instruction, basic block,
+     *  etc. Therefore each modification publishes a new immutable snapshot (an array) of the callbacks, and apply() iterates
+     *  over the current snapshot without obtaining a lock or allocating memory.  A superseded snapshot might still be in use
+     *  by a concurrent (or enclosing) apply(), so it is retired rather than freed.  Each apply() counts itself as a reader of
+     *  the list, and retired snapshots are freed as soon as the list has no readers: either by the modification that retires
+     *  them or by the last apply() to return.  Therefore the retired snapshots are bounded by the number of modifications
+     *  made while at least one apply() is continuously in progress. */
     template<class T>
     class List {
     public:
         typedef T CallbackType;                                 /**< Functor class. */
         typedef std::list<CallbackType*> CBList;                /**< Standard vector of functor pointers. */
 
-        List() {
+        List(): snapshot(NULL), nreaders(0), nretired(0) {
             RTS_mutex_init(&mutex, RTS_LAYER_ROSE_CALLBACKS_LIST_OBJ, NULL);
         }
 
-        explicit List(CallbackType *callback) {
+        explicit List(CallbackType *callback): snapshot(NULL), nreaders(0), nretired(0) {
             RTS_mutex_init(&mutex, RTS_LAYER_ROSE_CALLBACKS_LIST_OBJ, NULL);
             append(callback);
         }
 
+        /** Copies the callbacks (but not the functors) of another list. */
+        List(const List &other): snapshot(NULL), nreaders(0), nretired(0) {
+            RTS_mutex_init(&mutex, RTS_LAYER_ROSE_CALLBACKS_LIST_OBJ, NULL);
+            CBList other_list = other.callbacks();
+            RTS_MUTEX(mutex) {
+                list = other_list;
+                publish();
+            } RTS_MUTEX_END;
+        }
+
+        ~List() {
+            delete snapshot;
+            for (size_t i=0; i<retired.size(); ++i)
+                delete retired[i];
+        }
+
+        /** Replaces the callbacks of this list with the callbacks (but not copies of the functors) of another list.
+         *
+         *  Thread safety: This method is thread safe. */
+        List& operator=(const List &other) {
+            if (this!=&other) {
+                CBList other_list = other.callbacks();
+                RTS_MUTEX(mutex) {
+                    list = other_list;
+                    publish();
+                } RTS_MUTEX_END;
+            }
+            return *this;
+        }
+
         /** Returns the number of callbacks in the list.
          *
          *  Thread safety: This method is thread safe. */
         size_t size() const {
-            size_t retval = 0;
-            RTS_MUTEX(mutex) {
-                retval = list.size();
-            } RTS_MUTEX_END;
-            return retval;
+            Reader r(this);
+            return r.snapshot ? r.snapshot->size() : 0;
         }
 
         /** Predicate to test whether the list is empty.  Returns true if the list is empty, false otherwise.
          *
          *  Thread safety: This method is thread safe. */
         bool empty() const {
-            bool retval = false;
-            RTS_MUTEX(mutex) {
-                retval = list.empty();
-            } RTS_MUTEX_END;
-            return retval;
+            Reader r(this);
+            return NULL==r.snapshot;
         }
 
         /** Append a functor to the end of the list without copying it.  Functors can be inserted more than once into a list,
@@ -121,6 +155,7 @@ namespace ROSE_Callbacks {
             RTS_MUTEX(mutex) {
                 assert(cb!=NULL);
                 list.push_back(cb);
+                publish();
             } RTS_MUTEX_END;
             return *this;
         }
@@ -134,6 +169,7 @@ namespace ROSE_Callbacks {
             RTS_MUTEX(mutex) {
                 assert(cb!=NULL);
                 list.push_front(cb);
+                publish();
             } RTS_MUTEX_END;
             return *this;
         }
@@ -152,6 +188,7 @@ namespace ROSE_Callbacks {
                         --nreplacements;
                     }
                 }
+                publish();
             } RTS_MUTEX_END;
             return *this;
         }
@@ -171,6 +208,7 @@ namespace ROSE_Callbacks {
                         --nreplacements;
                     }
                 }
+                publish();
             } RTS_MUTEX_END;
             return *this;
         }
@@ -199,6 +237,7 @@ namespace ROSE_Callbacks {
                         }
                     }
                 }
+                publish();
             } RTS_MUTEX_END;
             return *this;
         }
@@ -229,6 +268,8 @@ namespace ROSE_Callbacks {
                         }
                     }
                 }
+                if (erased)
+                    publish();
             } RTS_MUTEX_END;
             return erased;
         }
@@ -240,6 +281,7 @@ namespace ROSE_Callbacks {
         List& clear() {
             RTS_MUTEX(mutex) {
                 list.clear();
+                publish();
             } RTS_MUTEX_END;
             return *this;
         }
@@ -248,11 +290,8 @@ namespace ROSE_Callbacks {
          *
          *  Thread safety: This method is thread safe. */
         std::list<CallbackType*> callbacks() const {
-            CBList retval;
-            RTS_MUTEX(mutex) {
-                retval = list;
-            } RTS_MUTEX_END;
-            return retval;
+            Reader r(this);
+            return r.snapshot ? CBList(r.snapshot->begin(), r.snapshot->end()) : CBList();
         }
 
         /** Invokes all functors in the callback list.  The functors are invoked sequentially in the order specified by calling
@@ -264,25 +303,99 @@ namespace ROSE_Callbacks {
          *  Thread safety:  This method is thread safe.  If this list is modified by one or more of the functors on this list
          *  or by another thread, those changes do not affect which callbacks are made by this invocation of apply().  The
          *  callbacks should not assume that any particular mutexes or other thread synchronization resources are held. It is
-         *  possible for a single callback to be invoked concurrently if two or more threads invoke apply() concurrently. */
+         *  possible for a single callback to be invoked concurrently if two or more threads invoke apply() concurrently.
+         *
+         *  This method does not allocate, and it locks only when it is the last reader of a list that has retired snapshots: it
+         *  iterates over the snapshot that was current when it was called. */
         template<class ArgumentType>
         bool apply(bool b, const ArgumentType &args, Direction dir=FORWARD) const {
-            CBList list = callbacks(); /* copy, so callbacks can safely modify this object's list */
+            Reader r(this);
+            const Snapshot *s = r.snapshot;
+            if (!s)
+                return b;
             if (FORWARD==dir) {
-                for (typename CBList::iterator li=list.begin(); li!=list.end(); ++li) {
-                    b = (**li)(b, args);
+                for (typename Snapshot::const_iterator si=s->begin(); si!=s->end(); ++si) {
+                    b = (**si)(b, args);
                 }
             } else {
-                for (typename CBList::reverse_iterator li=list.rbegin(); li!=list.rend(); ++li) {
-                    b = (**li)(b, args);
+                for (typename Snapshot::const_reverse_iterator si=s->rbegin(); si!=s->rend(); ++si) {
+                    b = (**si)(b, args);
                 }
             }
             return b;
         }
 
     private:
+        typedef std::vector<CallbackType*> Snapshot;            /**< Immutable once published. */
+
+        /* Counts itself as a reader of a list for its lifetime and holds the snapshot that was current when it was
+         * constructed.  The snapshot is not freed while any reader exists, even if a callback throws. */
+        struct Reader {
+            const List *list;
+            const Snapshot *snapshot;
+            explicit Reader(const List *list): list(list), snapshot(list->acquire()) {}
+            ~Reader() { list->release(); }
+        };
+        friend struct Reader;
+
+        /* Registers a reader and returns the current snapshot, or null if the list is empty. */
+        const Snapshot *acquire() const {
+#ifdef RTS_ATOMIC_POINTERS
+            RTS_atomic_add(nreaders, 1);                        /* full barrier: the load below cannot move above it */
+            return RTS_atomic_load(snapshot);
+#else
+            const Snapshot *retval = NULL;
+            RTS_MUTEX(mutex) {
+                ++nreaders;
+                retval = snapshot;
+            } RTS_MUTEX_END;
+            return retval;
+#endif
+        }
+
+        /* Unregisters a reader. The last reader frees the retired snapshots, if any. */
+        void release() const {
+#ifdef RTS_ATOMIC_POINTERS
+            if (0==RTS_atomic_add(nreaders, -1) && nretired>0) {
+                RTS_MUTEX(mutex) {
+                    reclaim();
+                } RTS_MUTEX_END;
+            }
+#else
+            RTS_MUTEX(mutex) {
+                --nreaders;
+                reclaim();
+            } RTS_MUTEX_END;
+#endif
+        }
+
+        /* Frees the retired snapshots if there are no readers. The caller must hold the mutex.  Retired snapshots are no longer
+         * published, so a reader that arrives after the check below cannot obtain one. */
+        void reclaim() const {
+            if (nretired>0 && 0==RTS_atomic_add(nreaders, 0)) {
+                for (size_t i=0; i<retired.size(); ++i)
+                    delete retired[i];
+                retired.clear();
+                nretired = 0;
+            }
+        }
+
+        /* Publishes a snapshot of the list and retires the previous one. The caller must hold the mutex. */
+        void publish() {
+            if (const Snapshot *old_snapshot = snapshot) {
+                retired.push_back(old_snapshot);
+                nretired = retired.size();
+            }
+            RTS_atomic_publish(snapshot, list.empty() ? (const Snapshot*)NULL : new Snapshot(list.begin(), list.end()));
+            reclaim();
+        }
+
         mutable RTS_mutex_t mutex;
-        CBList list;
+        CBList list;                                            /* Protected by mutex. */
+        const Snapshot * volatile snapshot;                     /* Current snapshot; null when the list is empty. */
+        mutable volatile size_t nreaders;                       /* Number of Reader objects for this list. */
+        mutable std::vector<const Snapshot*> retired;           /* Superseded snapshots, protected by mutex. */
+        mutable volatile size_t nretired;                       /* Size of "retired", readable without the mutex. */
     };
 }
 
@@ -94,9 +94,11 @@ enum RTS_Layer {
 
     /* ROSE library layers, 100-199 */
     RTS_LAYER_ROSE_CALLBACKS_LIST_OBJ   = 100,          /**< ROSE_Callbacks::List class */
+    RTS_LAYER_ROSE_STRING_STORAGE_CLASS = 101,          /**< SgAsmStringStorage lazy strings (acquires no other locks) */
     RTS_LAYER_RTS_MESSAGE_CLASS         = 105,          /**< RTS_Message class */
     RTS_LAYER_DISASSEMBLER_CLASS        = 110,          /**< Disassembler class */
     RTS_LAYER_ROSE_SMT_SOLVERS          = 115,          /**< SMTSolver class */
+    RTS_LAYER_ROSE_ASM_UNPARSER_OBJ     = 120,          /**< AsmUnparser objects */
 
     /* Simulator layers (see projects/simulator), 200-220
      *
@@ -226,6 +228,53 @@ int RTS_mutex_lock(RTS_mutex_t*);
 /** Release an exclusive lock.  Behavior is similar to pthread_mutex_unlock(). Returns zero on success, errno on failure. */
 int RTS_mutex_unlock(RTS_mutex_t*);
 
+/******************************************************************************************************************************
+ *                                      Publication of immutable objects
+ ******************************************************************************************************************************/
+
+/** Read a pointer published by RTS_atomic_publish().
+ *
+ *  The object pointed to by the return value is completely initialized, no matter which thread published it.  Readers do not
+ *  acquire any lock, so the publisher must not modify or free an object once it has been published.  The RTS_ATOMIC_POINTERS
+ *  symbol is defined when these functions are lock-free and safe to use concurrently; otherwise callers need to hold the same
+ *  lock as the publisher. */
+#if !defined(ROSE_THREADS_ENABLED) || defined(__GNUC__)
+#  define RTS_ATOMIC_POINTERS
+#endif
+
+template<typename T>
+inline T *RTS_atomic_load(T * const volatile &ptr) {
+    T *retval = ptr;
+#if defined(ROSE_THREADS_ENABLED) && defined(__GNUC__)
+#  if defined(__i386__) || defined(__x86_64__)
+    __asm__ __volatile__("" ::: "memory");              /* x86 does not reorder loads with other loads */
+#  else
+    __sync_synchronize();
+#  endif
+#endif
+    return retval;
+}
+
+/** Publish a pointer for RTS_atomic_load().  All writes to the object made before this call are visible to threads that read
+ *  the new pointer. */
+template<typename T>
+inline void RTS_atomic_publish(T * volatile &ptr, T *value) {
+#if defined(ROSE_THREADS_ENABLED) && defined(__GNUC__)
+    __sync_synchronize();
+#endif
+    ptr = value;
+}
+
+/** Add to a counter and return its new value.  The addition is a full memory barrier: no load or store is reordered across
+ *  it, so adding zero is a way to read the counter after all preceding stores are visible.  Like RTS_atomic_load(), this
+ *  is only safe without a lock when RTS_ATOMIC_POINTERS is defined. */
+inline size_t RTS_atomic_add(volatile size_t &counter, long delta) {
+#if defined(ROSE_THREADS_ENABLED) && defined(__GNUC__)
+    return __sync_add_and_fetch(&counter, (size_t)delta);
+#else
+    return counter += (size_t)delta;
+#endif
+}
 
 
 
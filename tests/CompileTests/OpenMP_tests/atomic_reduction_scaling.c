@@ -0,0 +1,97 @@
+/* Time "omp atomic" updates and reductions with 1 to 32 threads, checking the results.
+ * Many short parallel regions are used for the reductions so that the cost of combining 
+ * the partial results of the threads shows.
+ * Like in falsesharing.c, the Omni runtime complains about more threads than cores, 
+ * so the thread counts are limited by omp_get_num_procs().
+ */
+#include <stdio.h>
+#include <omp.h>
+
+#define MAX_THREADS 32
+#define N 1000000
+#define REGIONS 1000
+#define M 1000
+
+int main (void)
+{
+  int nthreads, r, i;
+  int errors = 0;
+  long expected_sum = 0;
+  int expected_xor = 0;
+
+  for (r = 0; r < REGIONS; r++)
+    for (i = 0; i < M; i++)
+    {
+      expected_sum += i;
+      expected_xor ^= i;
+    }
+
+  for (nthreads = 1; nthreads <= MAX_THREADS; nthreads *= 2)
+  {
+    int count = 0;
+    double dsum = 0.0;
+    float fcount = 0.0f;
+    float fdiff = 0.0f;
+    double ddiff = 0.0;
+    unsigned u = 2;
+    unsigned scaled = 1;
+    long sum = 0, diff = 0;
+    int bits = 0;
+    float fsum = 0.0f;
+    double t0, t_atomic, t_reduction;
+
+    if (nthreads > 1 && nthreads > omp_get_num_procs())
+      break;
+    omp_set_num_threads(nthreads);
+
+    t0 = omp_get_wtime();
+#pragma omp parallel for
+    for (i = 0; i < N; i++)
+    {
+#pragma omp atomic
+      count++;
+#pragma omp atomic
+      dsum += 0.5;
+#pragma omp atomic
+      fcount += 0.5f;
+      /* an unsigned value subtracted from a floating point variable must not wrap around */
+#pragma omp atomic
+      fdiff -= u;
+#pragma omp atomic
+      ddiff -= u;
+      if (i % (N / 8) == 0)
+      {
+#pragma omp atomic
+        scaled *= 2;
+      }
+    }
+    t_atomic = omp_get_wtime() - t0;
+
+    t0 = omp_get_wtime();
+    for (r = 0; r < REGIONS; r++)
+    {
+#pragma omp parallel for reduction(+:sum,fsum) reduction(-:diff) reduction(^:bits)
+      for (i = 0; i < M; i++)
+      {
+        sum += i;
+        diff -= i;
+        bits ^= i;
+        fsum += 0.5;
+      }
+    }
+    t_reduction = omp_get_wtime() - t0;
+
+    if (count != N || dsum != 0.5 * N || fcount != 0.5 * N || fdiff != -2.0 * N || ddiff != -2.0 * N || scaled != 256)
+    {
+      printf("threads=%d: wrong atomic results %d %f %f %f %f %u\n", nthreads, count, dsum, fcount, fdiff, ddiff, scaled);
+      errors++;
+    }
+    if (sum != expected_sum || diff != -expected_sum || bits != expected_xor || fsum != 0.5 * M * REGIONS)
+    {
+      printf("threads=%d: wrong reduction results %ld %ld %d %f\n", nthreads, sum, diff, bits, fsum);
+      errors++;
+    }
+    printf("threads=%2d  atomic: %.4f sec  reduction: %.4f sec\n", nthreads, t_atomic, t_reduction);
+  }
+  return errors;
+}
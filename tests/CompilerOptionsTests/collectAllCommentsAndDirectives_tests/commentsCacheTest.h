@@ -0,0 +1,19 @@
+// Header shared by commentsCacheTest1.C and commentsCacheTest2.C; its comments 
+// and CPP directives are collected once and then taken from the cache.
+
+#ifndef COMMENTS_CACHE_TEST_H
+#define COMMENTS_CACHE_TEST_H
+
+/* A C style comment
+   spanning several lines */
+#define SCALE 2
+
+// Comment before a declaration
+int scale(int x);
+
+#if SCALE > 1
+// Comment inside a conditional directive
+inline int twice(int x) { return SCALE * x; } // trailing comment
+#endif
+
+#endif